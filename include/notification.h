@@ -1033,6 +1033,38 @@ notification_error_e notification_get_pkgname(notification_h noti,
 notification_error_e notification_set_badge(const char *pkgname,
 					    int group_id, int count);
 
+/**
+ * @brief This function add delta to application badge count.
+ * @details Badge is created with count 0 if it does not exist,
+ * then delta is added in one DB transaction, so no other process can
+ * change the count between get and set.
+ * @remarks Count does not go below 0.
+ * @param[in] pkgname If NULL, caller pkgname is set internally.
+ * @param[in] group_id group id
+ * @param[in] delta count to add, negative to subtract
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_FROM_DB - Error from DB query
+ * @pre
+ * @post
+ * @see notification_set_badge()
+ * @see notification_get_badge()
+ * @par Sample code:
+#include <notification.h>
+ ...
+  {
+	 notification_error_e noti_err = NOTIFICATION_ERROR_NONE;
+
+	 noti_err  = notification_add_badge(NULL, NOTIFICATION_GROUP_ID_NONE, 1);
+	 if(noti_err != NOTIFICATION_ERROR_NONE) {
+		 return;
+	 }
+ }
+ * @endcode
+ */
+notification_error_e notification_add_badge(const char *pkgname,
+					    int group_id, int delta);
+
 /**
  * @brief This function get application badge count.
  * @details
@@ -1154,6 +1186,41 @@ notification_error_e notification_get_type(notification_h noti,
 notification_error_e notification_insert(notification_h noti,
 					 int *priv_id);
 
+/**
+ * @brief This function insert several notification data at once.
+ * @details All notification data are inserted to DB in one transaction, and display applications are notified once.
+ * If one of them can not be inserted, none of them is inserted.
+ * @remarks Use this instead of calling notification_insert() in a loop when many notifications are posted together.
+ * @param[in] notis array of notification handles
+ * @param[in] n number of notification handles in notis
+ * @param[out] priv_ids array of n private IDs, may be NULL
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_ALREADY_EXIST_ID - one of private IDs is already used
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre notification_new()
+ * @post notification_free()
+ * @see notification_insert()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+ {
+	notification_h notis[2] = { noti1, noti2 };
+	int priv_ids[2] = { 0, };
+	notification_error_e noti_err = NOTIFICATION_ERROR_NONE;
+
+	noti_err  = notification_insert_batch(notis, 2, priv_ids);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e notification_insert_batch(notification_h * notis,
+					       int n, int *priv_ids);
+
 /**
  * @brief This function update notification data.
  * @details Display application update UI.
@@ -1331,6 +1398,39 @@ notification_error_e notification_delete_by_priv_id(const char *pkgname,
 						    notification_type_e type,
 						    int priv_id);
 
+/**
+ * @brief This function delete notification data of several private IDs at once.
+ * @details If pkgname is NULL, caller_pkgname is set internally.
+ * Rows are deleted in one transaction, and display applications are notified once only if a row is deleted.
+ * @remarks Private IDs which do not exist are skipped, and they are not notified.
+ * @param[in] pkgname caller application package name or NULL
+ * @param[in] priv_ids array of private IDs
+ * @param[in] n number of private IDs in priv_ids
+ * @return number of deleted notifications if success, negative notification_error_e value if failure
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - Invalide input value
+ * @retval NOTIFICATION_ERROR_NO_MEMORY - not enough memory
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error, nothing is deleted
+ * @pre
+ * @post
+ * @see notification_delete_by_priv_id()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+ {
+	int priv_ids[3] = { APP_PRIV_ID1, APP_PRIV_ID2, APP_PRIV_ID3 };
+	int deleted = 0;
+
+	deleted  = notification_delete_batch(NULL, priv_ids, 3);
+	if(deleted < 0) {
+		return;
+	}
+}
+ * @endcode
+ */
+int notification_delete_batch(const char *pkgname, const int *priv_ids,
+			      int n);
+
 /**
  * @brief This function delete notification data from DB
  * @details notification_delete() remove notification data from DB and notification_free release menory of notification data.
@@ -1581,6 +1681,373 @@ notification_error_e
 notification_unresister_changed_cb(
 	void (*changed_cb)(void *data, notification_type_e type));
 
+/**
+ * @brief This function register notification changed callback, which gets
+ * what is changed.
+ * @details detailed_changed_cb is called with the operation, package name,
+ * type and private ids of changed notifications, so the view can update only
+ * the changed rows.
+ * @remarks pkgname is NULL and type is NOTIFICATION_TYPE_NONE if they are not
+ * known, as for NOTIFICATION_OP_NONE sent by older library or
+ * NOTIFICATION_OP_DELETE_ALL of all packages.\n
+ * priv_ids is NULL for NOTIFICATION_OP_NONE and NOTIFICATION_OP_DELETE_ALL,
+ * reload list for NOTIFICATION_OP_NONE.\n
+ * pkgname and priv_ids are valid only in the callback.
+ * @param[in] detailed_changed_cb callback function
+ * @param[in] user_data user data
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_FROM_DBUS - Error from DBus
+ * @pre
+ * @post
+ * @see #notification_op_type_e
+ * @see notification_unresister_detailed_changed_cb()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	noti_err = notification_resister_detailed_changed_cb(app_detailed_changed_cb, user_data);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e
+notification_resister_detailed_changed_cb(
+	void (*detailed_changed_cb)(void *data, notification_op_type_e op,
+				    const char *pkgname,
+				    notification_type_e type,
+				    const int *priv_ids, int num_priv_ids),
+	void *user_data);
+
+/**
+ * @brief This function register notification changed callback, which gets
+ * changes of a package, type or display application only.
+ * @details Filter is installed as match rules of the bus, so signals of other
+ * changes are dropped by the bus and do not wake up the process.
+ * detailed_changed_cb is called as one of
+ * notification_resister_detailed_changed_cb().
+ * @remarks Changes of unknown package or type, as NOTIFICATION_OP_NONE or
+ * NOTIFICATION_OP_DELETE_ALL of all packages, match any filter.\n
+ * Deleted notifications are not read, so deletes match any applist.\n
+ * Signals of older library have no filter args and are not received.\n
+ * Unregister it by notification_unresister_detailed_changed_cb().
+ * @param[in] detailed_changed_cb callback function
+ * @param[in] pkgname package name of changes, NULL for any package
+ * @param[in] type type of changes, NOTIFICATION_TYPE_NONE for any type
+ * @param[in] applist OR of NOTIFICATION_DISPLAY_APP_NOTIFICATION_TRAY,
+ * NOTIFICATION_DISPLAY_APP_TICKER, NOTIFICATION_DISPLAY_APP_LOCK and
+ * NOTIFICATION_DISPLAY_APP_INDICATOR, or NOTIFICATION_DISPLAY_APP_ALL
+ * @param[in] user_data user data
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_NO_MEMORY - not enough memory
+ * @retval NOTIFICATION_ERROR_FROM_DBUS - Error from DBus
+ * @pre
+ * @post
+ * @see notification_resister_detailed_changed_cb()
+ * @see notification_unresister_detailed_changed_cb()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	noti_err = notification_resister_filtered_changed_cb(app_detailed_changed_cb,
+		NULL, NOTIFICATION_TYPE_NOTI, NOTIFICATION_DISPLAY_APP_TICKER, user_data);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e
+notification_resister_filtered_changed_cb(
+	void (*detailed_changed_cb)(void *data, notification_op_type_e op,
+				    const char *pkgname,
+				    notification_type_e type,
+				    const int *priv_ids, int num_priv_ids),
+	const char *pkgname, notification_type_e type, int applist,
+	void *user_data);
+
+/**
+ * @brief This function unregister notification changed callback, which gets
+ * what is changed.
+ * @details
+ * @remarks
+ * @param[in] detailed_changed_cb callback function
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @pre
+ * @post
+ * @see notification_resister_detailed_changed_cb()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	noti_err = notification_unresister_detailed_changed_cb(app_detailed_changed_cb);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e
+notification_unresister_detailed_changed_cb(
+	void (*detailed_changed_cb)(void *data, notification_op_type_e op,
+				    const char *pkgname,
+				    notification_type_e type,
+				    const int *priv_ids, int num_priv_ids));
+
+/**
+ * @brief This function set coalescing window of changed notifications sent by
+ * this process.
+ * @details When msec is not 0, changes made by insert, update and delete are
+ * kept for msec and merged, then sent as one changed notification for each
+ * operation, package and type. A notification inserted and deleted in the
+ * window is not sent at all.
+ * @remarks Default is 0, changes are sent at once.\n
+ * Pending changes are sent by a thread of the library, so the process needs
+ * no main loop, and at exit. Setting 0 sends pending changes at once.\n
+ * Changes which touched no notification are never sent.
+ * @param[in] msec coalescing window in milliseconds, 16 to 50 is recommended
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - msec is negative
+ * @pre
+ * @post
+ * @see notification_resister_detailed_changed_cb()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	noti_err = notification_set_changed_coalescing(30);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e notification_set_changed_coalescing(int msec);
+
+/**
+ * @brief This function set minimum interval of ongoing updates sent by this
+ * process.
+ * @details notification_update_progress(), notification_update_size() and
+ * notification_update_content() of a notification are sent at most once in
+ * msec. An update made in the interval is kept and sent when the interval is
+ * over, a newer one replaces it, so only the latest value is sent and the last
+ * value is always sent.
+ * @remarks Default is 100 milliseconds. Setting 0 sends every update and sends
+ * kept updates at once.\n
+ * Kept updates are sent by a thread of this library, main loop is not needed.
+ * @param[in] msec minimum interval in milliseconds
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - msec is negative
+ * @pre
+ * @post
+ * @see notification_update_progress()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	noti_err = notification_set_ongoing_update_interval(50);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e notification_set_ongoing_update_interval(int msec);
+
+/**
+ * @brief This function open shared memory channel of ongoing updates as viewer.
+ * @details While the channel is open, progress and size updates of all
+ * processes are written to a ring in shared memory, and read by
+ * notification_ongoing_channel_read() without message parsing.
+ * They are sent by D-Bus signal too, so other viewers keep getting them.
+ * Content updates are sent by D-Bus signal only.
+ * @remarks Only one process reads the channel, the user who created the
+ * shared memory object. It is writable by applications of the notification
+ * group only.\n
+ * Processes stop writing to the channel in a second after it is closed
+ * or the viewer exits.
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_NO_MEMORY - shared memory is not available
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - shared memory has unknown layout
+ * @retval NOTIFICATION_ERROR_ALREADY_EXIST_ID - other process reads the channel
+ * @retval NOTIFICATION_ERROR_PERMISSION_DENIED - shared memory is owned by other user
+ * @pre
+ * @post notification_ongoing_channel_close()
+ * @see notification_ongoing_channel_read()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	noti_err = notification_ongoing_channel_open();
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e notification_ongoing_channel_open(void);
+
+/**
+ * @brief This function open shared memory channel of ongoing updates as viewer, with option.
+ * @details Same as notification_ongoing_channel_open(). With
+ * NOTIFICATION_ONGOING_CHANNEL_OPTION_EXCLUSIVE, progress and size updates
+ * are not sent by D-Bus signal while the channel is open, so other viewers
+ * subscribing update_progress and update_size get none of them.
+ * @remarks EXCLUSIVE is honored only if the viewer runs as root and created
+ * the shared memory object, otherwise updates are sent by D-Bus signal too.
+ * @param[in] option bitwise OR of NOTIFICATION_ONGOING_CHANNEL_OPTION_XXX
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_NO_MEMORY - shared memory is not available
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid option or shared memory has unknown layout
+ * @retval NOTIFICATION_ERROR_ALREADY_EXIST_ID - other process reads the channel
+ * @retval NOTIFICATION_ERROR_PERMISSION_DENIED - shared memory is owned by other user
+ * @pre
+ * @post notification_ongoing_channel_close()
+ * @see notification_ongoing_channel_open()
+ */
+notification_error_e notification_ongoing_channel_open_ex(int option);
+
+/**
+ * @brief This function read updates from shared memory channel.
+ * @details update_cb is called for each update written since last read. If
+ * there is none, it waits up to timeout_msec for one.
+ * @remarks Callbacks are called in the thread calling this function.\n
+ * Updates are lost if more than 256 are written between reads, the latest
+ * ones are kept.
+ * @param[in] update_cb callback called for each update
+ * @param[in] user_data user data passed to update_cb
+ * @param[in] timeout_msec milliseconds to wait, 0 not to wait, -1 to wait forever
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - channel is not open or update_cb is NULL
+ * @pre notification_ongoing_channel_open()
+ * @post
+ * @see notification_ongoing_channel_open()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+static void update_cb(void *data, notification_ongoing_update_type_e type,
+		      const char *pkgname, int priv_id, double value)
+{
+	...
+}
+
+static void *read_thread(void *data)
+{
+	while (notification_ongoing_channel_read(update_cb, NULL, -1) ==
+	       NOTIFICATION_ERROR_NONE) ;
+	return NULL;
+}
+ * @endcode
+ */
+notification_error_e
+notification_ongoing_channel_read(void (*update_cb)(void *data,
+						    notification_ongoing_update_type_e type,
+						    const char *pkgname,
+						    int priv_id, double value),
+				  void *user_data, int timeout_msec);
+
+/**
+ * @brief This function close shared memory channel of ongoing updates.
+ * @details Processes send progress and size updates by D-Bus signal only again.
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @pre notification_ongoing_channel_open()
+ * @post
+ * @see notification_ongoing_channel_open()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	noti_err = notification_ongoing_channel_close();
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e notification_ongoing_channel_close(void);
+
+/**
+ * @brief This function register badge changed callback.
+ * @details changed_cb is called with pkgname, group id and new count
+ * whenever a badge is set by notification_set_badge() or
+ * notification_add_badge() in any process.
+ * @remarks Callback is called in main loop of the caller.
+ * @param[in] changed_cb callback function
+ * @param[in] user_data user data
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_FROM_DBUS - Error from DBus
+ * @pre
+ * @post
+ * @see notification_unresister_badge_changed_cb()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	noti_err = notification_resister_badge_changed_cb(app_badge_changed_cb, user_data);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e
+notification_resister_badge_changed_cb(
+	void (*changed_cb)(void *data, const char *pkgname, int group_id,
+			   int count),
+	void *user_data);
+
+/**
+ * @brief This function unregister badge changed callback.
+ * @details
+ * @remarks
+ * @param[in] changed_cb callback function
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @pre
+ * @post
+ * @see notification_resister_badge_changed_cb()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	noti_err = notification_unresister_badge_changed_cb(app_badge_changed_cb);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+}
+ * @endcode
+ */
+notification_error_e
+notification_unresister_badge_changed_cb(
+	void (*changed_cb)(void *data, const char *pkgname, int group_id,
+			   int count));
+
 /**
  * @brief This function get notification data count.
  * @details Count is the result of the conditions that type, pkgname, group_id, priv_id.
@@ -1658,6 +2125,127 @@ notification_error_e notification_get_grouping_list(notification_type_e type,
 						    int count,
 						    notification_list_h *list);
 
+/**
+ * @brief This function return notification grouping list handle, read with fetch option.
+ * @details Same as notification_get_grouping_list(), fetch_option sets how this list is read from DB.
+ * With NOTIFICATION_FETCH_OPTION_SUMMARY, execute option and services are not read with list.
+ * They are read from DB when notification_get_execute_option() is called, so list showing only text and image is read faster.
+ * With NOTIFICATION_FETCH_OPTION_ARENA, notifications of the list are allocated together and released at once by notification_free_list().
+ * @remarks Fetch option applies to this call only.\n
+ * Notification of list read with NOTIFICATION_FETCH_OPTION_ARENA is not valid after notification_free_list(), unless it is detached by notification_detach().
+ * @param[in] type notification type
+ * @param[in] count returned notification data number, positive or -1 for all
+ * @param[in] fetch_option bitwise OR of NOTIFICATION_FETCH_OPTION_XXX
+ * @param[out] list notification list handle
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre
+ * @post notification_free_list()
+ * @see notification_get_grouping_list()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	notification_list_h noti_list = NULL;
+	notification_error_e noti_err = NOTIFICATION_ERROR_NONE;
+
+	noti_err = notification_get_grouping_list_ex(NOTIFICATION_TYPE_NONE, -1,
+			NOTIFICATION_FETCH_OPTION_SUMMARY | NOTIFICATION_FETCH_OPTION_ARENA, &noti_list);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+
+	...
+
+	notification_free_list(noti_list);
+}
+ * @endcode
+ */
+notification_error_e notification_get_grouping_list_ex(notification_type_e type,
+						       int count,
+						       int fetch_option,
+						       notification_list_h *list);
+
+/**
+ * @brief Position in notification grouping list, to get next page by notification_get_grouping_list_page()
+ */
+typedef struct _notification_page_token {
+	time_t time;	/**< time of last notification of previous page */
+	int rowid;	/**< DB row of last notification of previous page, 0 for first page */
+} notification_page_token_s;
+
+/**
+ * @brief This function return one page of notification grouping list handle.
+ * @details Newest notification of each group is returned, newest group first.
+ * Page starts after the notification stored in token, and token is updated to last notification of returned page.
+ * Every page is fetched in same time, regardless of page number.
+ * @remarks Set token to 0 before getting first page. If there is no more notification, list is not set.
+ * @param[in] type notification type
+ * @param[in] count maximum notification data number of page, -1 for all
+ * @param[in,out] token position in grouping list
+ * @param[out] list notification list handle
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre
+ * @post notification_free_list()
+ * @see #notification_page_token_s
+ * @see notification_get_grouping_list()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	notification_page_token_s token = { 0, };
+	notification_list_h noti_list = NULL;
+	notification_error_e noti_err = NOTIFICATION_ERROR_NONE;
+
+	noti_err = notification_get_grouping_list_page(NOTIFICATION_TYPE_NONE, 20, &token, &noti_list);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+
+	...
+
+	// Next page
+	noti_list = NULL;
+	noti_err = notification_get_grouping_list_page(NOTIFICATION_TYPE_NONE, 20, &token, &noti_list);
+}
+ * @endcode
+ */
+notification_error_e notification_get_grouping_list_page(notification_type_e type,
+							 int count,
+							 notification_page_token_s *token,
+							 notification_list_h *list);
+
+/**
+ * @brief This function return one page of notification grouping list handle, read with fetch option.
+ * @details Same as notification_get_grouping_list_page(), fetch_option is as of notification_get_grouping_list_ex().
+ * @remarks Fetch option applies to this call only.
+ * @param[in] type notification type
+ * @param[in] count maximum notification data number of page, -1 for all
+ * @param[in] fetch_option bitwise OR of NOTIFICATION_FETCH_OPTION_XXX
+ * @param[in,out] token position in grouping list
+ * @param[out] list notification list handle
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre
+ * @post notification_free_list()
+ * @see notification_get_grouping_list_page()
+ * @see notification_get_grouping_list_ex()
+ */
+notification_error_e notification_get_grouping_list_page_ex(notification_type_e type,
+							    int count,
+							    int fetch_option,
+							    notification_page_token_s *token,
+							    notification_list_h *list);
+
 /**
  * @brief This function return notification detail list handle of grouping data.
  * @details If count is -1, all of notification list is returned.
@@ -1694,6 +2282,173 @@ notification_error_e notification_get_detail_list(const char *pkgname,
 						  int count,
 						  notification_list_h *list);
 
+/**
+ * @brief This function return notification detail list handle of grouping data, read with fetch option.
+ * @details Same as notification_get_detail_list(), fetch_option is as of notification_get_grouping_list_ex().
+ * @remarks Fetch option applies to this call only.
+ * @param[in] pkgname caller application package name
+ * @param[in] group_id group id
+ * @param[in] priv_id private id
+ * @param[in] count returned notification data number, positive or -1 for all
+ * @param[in] fetch_option bitwise OR of NOTIFICATION_FETCH_OPTION_XXX
+ * @param[out] list notification list handle
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre
+ * @post notification_free_list()
+ * @see notification_get_detail_list()
+ * @see notification_get_grouping_list_ex()
+ */
+notification_error_e notification_get_detail_list_ex(const char *pkgname,
+						     int group_id,
+						     int priv_id,
+						     int count,
+						     int fetch_option,
+						     notification_list_h *list);
+
+/**
+ * @brief This function open cursor on notification grouping list.
+ * @details Same notifications as notification_get_grouping_list() are returned one by one by notification_cursor_next().
+ * Rows are read from DB only when notification_cursor_next() is called.
+ * @remarks Cursor should be closed by notification_cursor_close().
+ * @param[in] type notification type
+ * @param[out] cursor notification cursor handle
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_NO_MEMORY - not enough memory
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre
+ * @post notification_cursor_close()
+ * @see #notification_cursor_h
+ * @see notification_cursor_next()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	notification_cursor_h cursor = NULL;
+	notification_h noti = NULL;
+	notification_error_e noti_err = NOTIFICATION_ERROR_NONE;
+
+	noti_err = notification_cursor_open_grouping(NOTIFICATION_TYPE_NONE, &cursor);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+
+	while (notification_cursor_next(cursor, &noti) == NOTIFICATION_ERROR_NONE
+	       && noti != NULL) {
+		...
+		notification_free(noti);
+	}
+
+	notification_cursor_close(cursor);
+}
+ * @endcode
+ */
+notification_error_e notification_cursor_open_grouping(notification_type_e type,
+						       notification_cursor_h *cursor);
+
+/**
+ * @brief This function open cursor on notification grouping list, read with fetch option.
+ * @details Same as notification_cursor_open_grouping(), fetch_option is as of notification_get_grouping_list_ex().
+ * @remarks NOTIFICATION_FETCH_OPTION_ARENA is ignored, notifications of cursor are freed one by one.
+ * @param[in] type notification type
+ * @param[in] fetch_option bitwise OR of NOTIFICATION_FETCH_OPTION_XXX
+ * @param[out] cursor notification cursor handle
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_NO_MEMORY - not enough memory
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre
+ * @post notification_cursor_close()
+ * @see notification_cursor_open_grouping()
+ */
+notification_error_e notification_cursor_open_grouping_ex(notification_type_e type,
+							  int fetch_option,
+							  notification_cursor_h *cursor);
+
+/**
+ * @brief This function open cursor on notification detail list of grouping data.
+ * @details Same notifications as notification_get_detail_list() are returned one by one by notification_cursor_next().
+ * @remarks Cursor should be closed by notification_cursor_close().
+ * @param[in] pkgname caller application package name
+ * @param[in] group_id group id
+ * @param[in] priv_id private id
+ * @param[out] cursor notification cursor handle
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_NO_MEMORY - not enough memory
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre
+ * @post notification_cursor_close()
+ * @see #notification_cursor_h
+ * @see notification_cursor_open_grouping()
+ */
+notification_error_e notification_cursor_open_detail(const char *pkgname,
+						     int group_id,
+						     int priv_id,
+						     notification_cursor_h *cursor);
+
+/**
+ * @brief This function open cursor on notification detail list of grouping data, read with fetch option.
+ * @details Same as notification_cursor_open_detail(), fetch_option is as of notification_get_grouping_list_ex().
+ * @remarks NOTIFICATION_FETCH_OPTION_ARENA is ignored, notifications of cursor are freed one by one.
+ * @param[in] pkgname caller application package name
+ * @param[in] group_id group id
+ * @param[in] priv_id private id
+ * @param[in] fetch_option bitwise OR of NOTIFICATION_FETCH_OPTION_XXX
+ * @param[out] cursor notification cursor handle
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_NO_MEMORY - not enough memory
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre
+ * @post notification_cursor_close()
+ * @see notification_cursor_open_detail()
+ */
+notification_error_e notification_cursor_open_detail_ex(const char *pkgname,
+							int group_id,
+							int priv_id,
+							int fetch_option,
+							notification_cursor_h *cursor);
+
+/**
+ * @brief This function return next notification of cursor.
+ * @details If there is no more notification, noti is set NULL and NOTIFICATION_ERROR_NONE is returned.
+ * @remarks Returned noti should be freed by notification_free().
+ * @param[in] cursor notification cursor handle
+ * @param[out] noti notification handle or NULL
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @retval NOTIFICATION_ERROR_FROM_DB - DB error
+ * @pre notification_cursor_open_grouping() or notification_cursor_open_detail()
+ * @post notification_free()
+ * @see notification_cursor_open_grouping()
+ */
+notification_error_e notification_cursor_next(notification_cursor_h cursor,
+					      notification_h *noti);
+
+/**
+ * @brief This function close cursor.
+ * @details
+ * @remarks Notifications returned by notification_cursor_next() are not freed.
+ * @param[in] cursor notification cursor handle
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @pre notification_cursor_open_grouping() or notification_cursor_open_detail()
+ * @post
+ * @see notification_cursor_open_grouping()
+ */
+notification_error_e notification_cursor_close(notification_cursor_h cursor);
+
 /**
  * @brief This function release notification list.
  * @details
@@ -1724,6 +2479,39 @@ notification_error_e notification_get_detail_list(const char *pkgname,
  */
 notification_error_e notification_free_list(notification_list_h list);
 
+/**
+ * @brief This function keep notification of list valid after the list is released.
+ * @details Notification of list read with NOTIFICATION_FETCH_OPTION_ARENA is allocated together with the list.
+ * Detached notification is not freed by notification_free_list(), caller frees it by notification_free().
+ * @remarks It does nothing for other notifications, they are freed by notification_free_list() as before.\n
+ * Memory of whole list is kept until detached notifications are freed, use notification_clone() to keep few notifications of large list for long time.
+ * @param[in] noti notification handle of list
+ * @return NOTIFICATION_ERROR_NONE if success, other value if failure.
+ * @retval NOTIFICATION_ERROR_NONE - success
+ * @retval NOTIFICATION_ERROR_INVALID_DATA - invalid parameter
+ * @pre notification_get_grouping_list_ex() or notification_get_detail_list_ex() with NOTIFICATION_FETCH_OPTION_ARENA
+ * @post notification_free()
+ * @see notification_free_list()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	notification_list_h noti_list = NULL;
+	notification_h noti = NULL;
+
+	...
+
+	noti = notification_list_get_data(noti_list);
+	notification_detach(noti);
+	notification_free_list(noti_list);
+	...
+	notification_free(noti);
+}
+ * @endcode
+ */
+notification_error_e notification_detach(notification_h noti);
+
 /** 
  * @}
  */
@@ -0,0 +1,56 @@
+/*
+ *  libnotification
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Seungtaek Chung <seungtaek.chung@samsung.com>, Mi-Ju Lee <miju52.lee@samsung.com>, Xi Zhichan <zhichan.xi@samsung.com>, Youngsub Ko <ys4610.ko@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __NOTIFICATION_ARENA_H__
+#define __NOTIFICATION_ARENA_H__
+
+#include <stddef.h>
+
+#include <notification.h>
+
+/* Memory of a result set, released at once when last reference is
+ * dropped. Allocation is not thread safe, references are. */
+typedef struct _notification_arena notification_arena_s;
+
+/* New arena with one reference */
+notification_arena_s *notification_arena_create(void);
+
+void notification_arena_ref(notification_arena_s * arena);
+
+void notification_arena_unref(notification_arena_s * arena);
+
+/* Zero filled memory of arena */
+void *notification_arena_alloc(notification_arena_s * arena, size_t size);
+
+char *notification_arena_strdup(notification_arena_s * arena, const char *str);
+
+void *notification_arena_memdup(notification_arena_s * arena, const void *data,
+				size_t size);
+
+/* Free data unless it is in arena, arena may be NULL */
+void notification_arena_free(notification_arena_s * arena, void *data);
+
+/* Items appended to list from now on are allocated from arena, and list
+ * keeps a reference of arena until it is emptied */
+void notification_list_set_arena(notification_list_h list,
+				 notification_arena_s * arena);
+
+#endif				/* __NOTIFICATION_ARENA_H__ */
@@ -44,10 +44,59 @@ sqlite3 *notification_db_open(const char *dbfile);
 
 int notification_db_close(sqlite3 ** db);
 
+/* Get the connection shared in this process, opening it if needed.
+ * NULL if DB can not be opened or upgraded to current schema, upgrade is
+ * retried by next call. Every successful call must be paired with
+ * notification_db_release(). */
+sqlite3 *notification_db_acquire(void);
+
+void notification_db_release(sqlite3 ** db);
+
+/* Close the shared connection. It is reopened by the next acquire.
+ * If a cursor statement is open, closed when the last one is finalized. */
+void notification_db_fini(void);
+
 int notification_db_exec(sqlite3 * db, const char *query);
 
+/* BEGIN IMMEDIATE, the DB write lock is held until commit or rollback */
+int notification_db_begin(sqlite3 * db);
+
+int notification_db_commit(sqlite3 * db);
+
+int notification_db_rollback(sqlite3 * db);
+
+/* Prepare query on db, reusing the cached statement of the same query.
+ * Query must hold only bind parameters, never caller data.
+ * Returned statement must be given back by notification_db_finalize(). */
+sqlite3_stmt *notification_db_prepare(sqlite3 * db, const char *query);
+
+void notification_db_finalize(sqlite3_stmt * stmt);
+
+/* Prepare statement of a cursor, which is stepped across releases of DB.
+ * It is not cached, and must be given back by
+ * notification_db_finalize_cursor() with DB acquired. */
+sqlite3_stmt *notification_db_prepare_cursor(sqlite3 * db, const char *query);
+
+void notification_db_finalize_cursor(sqlite3_stmt * stmt);
+
+int notification_db_bind_text(sqlite3_stmt * stmt, const char *name,
+			      const char *str);
+
+/* NULL data or len 0 is bound as NULL */
+int notification_db_bind_blob(sqlite3_stmt * stmt, const char *name,
+			      const void *data, int len);
+
+int notification_db_bind_int(sqlite3_stmt * stmt, const char *name, int value);
+
+int notification_db_bind_double(sqlite3_stmt * stmt, const char *name,
+				double value);
+
 char *notification_db_column_text(sqlite3_stmt * stmt, int col);
 
+/* Copy of blob column, NULL if empty */
+char *notification_db_column_blob(sqlite3_stmt * stmt, int col, int *len);
+
+/* Decode bundle column, binary blob or text of older DB */
 bundle *notification_db_column_bundle(sqlite3_stmt * stmt, int col);
 
 #endif				/* __NOTIFICATION_DB_H__ */
@@ -38,6 +38,7 @@ typedef enum _notification_error {
 	NOTIFICATION_ERROR_ALREADY_EXIST_ID = -4,	/**< Already exist private ID */
 	NOTIFICATION_ERROR_FROM_DBUS = -5,	/**< Error from DBus */
 	NOTIFICATION_ERROR_NOT_EXIST_ID = -6,	/**< Not exist private ID */
+	NOTIFICATION_ERROR_PERMISSION_DENIED = -7,	/**< Permission denied */
 } notification_error_e;
 
 /** 
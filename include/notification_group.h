@@ -51,6 +51,9 @@ notification_error_e notification_group_get_content(const char *pkgname,
 notification_error_e notification_group_set_badge(const char *pkgname,
 						  int group_id, int count);
 
+notification_error_e notification_group_add_badge(const char *pkgname,
+						  int group_id, int delta);
+
 notification_error_e notification_group_get_badge(const char *pkgname,
 						  int group_id, int *count);
 
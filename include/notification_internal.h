@@ -26,12 +26,70 @@
 #define EXPORT_API __attribute__ ((visibility("default")))
 #endif
 
+/* Signals of notification changes */
+#define NOTI_DBUS_BUS_NAME 	"org.tizen.libnotification"
+#define NOTI_DBUS_PATH 		"/org/tizen/libnotification"
+#define NOTI_DBUS_INTERFACE 	"org.tizen.libnotification.signal"
+
+/* op, pkgname, type, priv_ids, then string args for match rules:
+ * type in decimal and "1" or "0" for each of NOTI_CHANGED_APPLIST bits */
+#define NOTI_CHANGED_NOTI	"notification_noti_changed"
+#define NOTI_CHANGED_ARG_PKGNAME	1
+#define NOTI_CHANGED_ARG_TYPE	4
+#define NOTI_CHANGED_ARG_APPLIST	5
+#define NOTI_CHANGED_APPLIST { \
+	NOTIFICATION_DISPLAY_APP_NOTIFICATION_TRAY, \
+	NOTIFICATION_DISPLAY_APP_TICKER, \
+	NOTIFICATION_DISPLAY_APP_LOCK, \
+	NOTIFICATION_DISPLAY_APP_INDICATOR, \
+}
+#define NOTI_CHANGED_APPLIST_NUM	4
+#define NOTI_CHANGED_ONGOING	"notification_ontoing_changed"
+#define NOTI_CHANGED_BADGE	"notification_badge_changed"	/* pkgname, group_id, count */
+
+/* Bundle columns of noti_list. A bundle read from DB is kept encoded in
+ * raw_bundle and decoded by notification_noti_decode_bundle() on first use.
+ * Text, key and image path are kept in slots of struct, they are bundles
+ * only in DB. Format args are typed, see notification_format_arg_s. */
+typedef enum _notification_bundle {
+	NOTIFICATION_BUNDLE_ARGS = 0,
+	NOTIFICATION_BUNDLE_GROUP_ARGS,
+	NOTIFICATION_BUNDLE_EXECUTE_OPTION,
+	NOTIFICATION_BUNDLE_SERVICE_RESPONDING,
+	NOTIFICATION_BUNDLE_SERVICE_SINGLE_LAUNCH,
+	NOTIFICATION_BUNDLE_SERVICE_MULTI_LAUNCH,
+	NOTIFICATION_BUNDLE_TEXT,
+	NOTIFICATION_BUNDLE_KEY,
+	NOTIFICATION_BUNDLE_FORMAT_ARGS,
+	NOTIFICATION_BUNDLE_IMAGE_PATH,
+	NOTIFICATION_BUNDLE_MAX,
+} notification_bundle_e;
+
+/* Format args blob of b_format_args column. Bundle encoded by older
+ * version does not start with 0 byte. Magic is followed by text type,
+ * number of args, then type and value of each arg for every text type
+ * having args. int and double are in host byte order, string is length
+ * then bytes without terminating 0. */
+#define NOTIFICATION_FORMAT_ARGS_MAGIC	"\0NFA"
+#define NOTIFICATION_FORMAT_ARGS_MAGIC_LEN	4
+
+/* Format string arg of notification_set_text() */
+typedef struct _notification_format_arg {
+	notification_variable_type_e type;
+	union {
+		int i;		/* INT, and notification_count_pos_type_e of COUNT */
+		double d;	/* DOUBLE */
+		char *s;	/* STRING */
+	} value;
+} notification_format_arg_s;
+
 struct _notification {
 	notification_type_e type;
 
 	int group_id;		/* Group ID */
 	int internal_group_id;	/* Internal Group ID */
 	int priv_id;		/* Private ID */
+	int rowid;		/* DB row, set only for notification read from DB */
 
 	char *caller_pkgname;	/* Caller App package name */
 	char *launch_pkgname;	/* Launch App package name. It will be from appsvc_set_pkgname */
@@ -46,12 +104,12 @@ struct _notification {
 	char *domain;		/* Text domain for localization */
 	char *dir;		/* Text dir for localization */
 
-	bundle *b_text;		/* basic text */
-	bundle *b_key;		/* key for localized text */
-	bundle *b_format_args;	/* args type and value for format string */
-	int num_format_args;	/* number of format string args */
+	char *text[NOTIFICATION_TEXT_TYPE_MAX];	/* basic text of text type */
+	char *key[NOTIFICATION_TEXT_TYPE_MAX];	/* key for localized text */
+	notification_format_arg_s *format_args[NOTIFICATION_TEXT_TYPE_MAX];	/* args for format string of text type */
+	int num_format_args[NOTIFICATION_TEXT_TYPE_MAX];	/* number of format string args */
 
-	bundle *b_image_path;	/* image path */
+	char *image_path[NOTIFICATION_IMAGE_TYPE_MAX];	/* image path of image type */
 
 	notification_sound_type_e sound_type;
 	char *sound_path;
@@ -67,10 +125,25 @@ struct _notification {
 	double progress_size;	/* size of progress */
 	double progress_percentage;	/* percentage of progress */
 
+	char *raw_bundle[NOTIFICATION_BUNDLE_MAX];	/* Encoded bundle not decoded yet */
+	int raw_bundle_len[NOTIFICATION_BUNDLE_MAX];	/* Bytes of raw_bundle */
+	int summary;		/* Execute option and services are not read from DB yet */
+
 	char *app_icon_path;	/* Temporary stored app icon path from AIL */
 	char *app_name;		/* Temporary stored app name from AIL */
 	char *temp_title;
 	char *temp_content;
+
+	/* Arena of list this is read into, struct and data read from DB are
+	 * in it. Detached notification keeps a reference of arena. */
+	struct _notification_arena *arena;
+	int detached;
+	int released;		/* Freed struct in arena, not detached any more */
 };
 
+/* Move notification to bucket of its key in lists having hash, after its
+ * caller_pkgname or priv_id is changed from old_pkgname and old_priv_id */
+void notification_list_rehash(struct _notification *noti,
+			      const char *old_pkgname, int old_priv_id);
+
 #endif				/* __NOTIFICATION_INTERNAL_H__ */
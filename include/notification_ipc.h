@@ -0,0 +1,48 @@
+/*
+ *  libnotification
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Seungtaek Chung <seungtaek.chung@samsung.com>, Mi-Ju Lee <miju52.lee@samsung.com>, Xi Zhichan <zhichan.xi@samsung.com>, Youngsub Ko <ys4610.ko@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __NOTIFICATION_IPC_H__
+#define __NOTIFICATION_IPC_H__
+
+#include <dbus/dbus.h>
+
+/* Environment variable with address of bus used instead of system bus,
+ * e.g. a private dbus-daemon for test */
+#define NOTIFICATION_IPC_ADDRESS_ENV "NOTIFICATION_DBUS_ADDRESS"
+
+/* New private connection to system bus, or bus of
+ * NOTIFICATION_IPC_ADDRESS_ENV. Caller closes and unrefs it. */
+DBusConnection *notification_ipc_open(void);
+
+/* Register fork and exit handlers of shared connection, it is called
+ * by notification_ipc_send() too. Modules sending under their own lock
+ * call it before registering their fork handlers, so that the lock of
+ * connection is taken after theirs before fork(). */
+void notification_ipc_init(void);
+
+/* Queue message on connection shared by library. It returns without
+ * waiting for the socket, message is written by background thread. */
+int notification_ipc_send(DBusMessage * message);
+
+/* Wait until queued messages are written */
+void notification_ipc_flush(void);
+
+#endif				/* __NOTIFICATION_IPC_H__ */
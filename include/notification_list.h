@@ -196,6 +196,108 @@ notification_list_h notification_list_get_next(notification_list_h list);
  */
 notification_h notification_list_get_data(notification_list_h list);
 
+/**
+ * @brief This function get count of notifications in notification list.
+ * @details 
+ * @remarks Any item of the list can be given, count of whole list is returned.
+ * @param[in] list notification list handle
+ * @return count of notifications, 0 if list is NULL
+ * @pre 
+ * @post
+ * @see #notification_list_h
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	notification_list_h noti_list = NULL;
+	notification_error_e noti_err = NOTIFICATION_ERROR_NONE;
+	int count = 0;
+
+	noti_err  = notification_get_grouping_list(NOTIFICATION_TYPE_NONE, -1, &noti_list);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+
+	count = notification_list_get_count(noti_list);
+}
+ * @endcode
+ */
+int notification_list_get_count(notification_list_h list);
+
+/**
+ * @brief This function get nth notification list handle from head.
+ * @details 
+ * @remarks Any item of the list can be given, nth is counted from head of list.
+ * @param[in] list notification list handle
+ * @param[in] nth index from head, 0 for head
+ * @return notification list handle if success, NULL if failure.
+ * @retval notification list handle(#notification_list_h) - success
+ * @retval NULL - failure, or nth is out of list
+ * @pre 
+ * @post
+ * @see #notification_list_h
+ * @see notification_list_get_count()
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+{
+	notification_list_h noti_list = NULL;
+	notification_error_e noti_err = NOTIFICATION_ERROR_NONE;
+
+	noti_err  = notification_get_grouping_list(NOTIFICATION_TYPE_NONE, -1, &noti_list);
+	if(noti_err != NOTIFICATION_ERROR_NONE) {
+		return;
+	}
+
+	noti_list = notification_list_get_nth(noti_list, 3);
+}
+ * @endcode
+ */
+notification_list_h notification_list_get_nth(notification_list_h list,
+					      int nth);
+
+/**
+ * @brief This function find notification list handle of caller package name
+ * and private id.
+ * @details 
+ * @remarks Hash of the list is built by first call, later calls take constant
+ * time.\n
+ * Notification given private id by notification_insert(), or package name
+ * by notification_set_pkgname() after it was appended is found by new ones.
+ * @param[in] list notification list handle
+ * @param[in] pkgname caller package name
+ * @param[in] priv_id private id
+ * @return notification list handle if success, NULL if failure.
+ * @retval notification list handle(#notification_list_h) - success
+ * @retval NULL - failure, or not found
+ * @pre 
+ * @post
+ * @see #notification_list_h
+ * @par Sample code:
+ * @code
+#include <notification.h>
+...
+static void app_detailed_changed_cb(void *data, notification_op_type_e op,
+				    const char *pkgname, notification_type_e type,
+				    const int *priv_ids, int num_priv_ids)
+{
+	notification_list_h noti_list = data;
+	notification_list_h found = NULL;
+	int i = 0;
+
+	for (i = 0; i < num_priv_ids; i++) {
+		found = notification_list_get_by_priv_id(noti_list, pkgname, priv_ids[i]);
+		...
+	}
+}
+ * @endcode
+ */
+notification_list_h notification_list_get_by_priv_id(notification_list_h list,
+						     const char *pkgname,
+						     int priv_id);
+
 /**
  * @brief This function append notification data in notification list.
  * @details 
@@ -233,7 +335,8 @@ notification_list_h notification_list_append(notification_list_h list,
 /**
  * @brief This function remove notification data from notification list.
  * @details 
- * @remarks
+ * @remarks Removed notification is not freed, caller frees it by notification_free().
+ * Notification of list read with NOTIFICATION_FETCH_OPTION_ARENA is detached by notification_detach() when it is removed, unless it is freed by notification_free() already.
  * @param[in] list notification list handle
  * @param[in] noti notification handle
  * @return notification handle if success, NULL if failure.
@@ -23,32 +23,85 @@
 #define __NOTIFICATION_NOTI_H__
 
 #include <notification.h>
+#include <notification_internal.h>
+
+/* Decode bundle field of noti which is still encoded as read from DB */
+void notification_noti_decode_bundle(notification_h noti,
+				     notification_bundle_e field);
+
+/* Free format args of text type, noti has no format args of it after */
+void notification_noti_free_format_args(notification_h noti,
+				       notification_text_type_e type);
 
 int notification_noti_insert(notification_h noti);
 
+int notification_noti_insert_batch(notification_h * notis, int n);
+
 int notification_noti_update(notification_h noti);
 
-int notification_noti_delete_all(notification_type_e type, const char *pkgname);
+int notification_noti_delete_all(notification_type_e type, const char *pkgname,
+				 int *num_deleted);
 
+/* priv_ids of deleted rows are returned in list_deleted if not NULL,
+ * caller frees it */
 int notification_noti_delete_group_by_group_id(const char *pkgname,
-					       int group_id);
+					       int group_id, int *num_deleted,
+					       int **list_deleted);
 
-int notification_noti_delete_group_by_priv_id(const char *pkgname, int priv_id);
+int notification_noti_delete_group_by_priv_id(const char *pkgname, int priv_id,
+					      int *num_deleted,
+					      int **list_deleted);
 
-int notification_noti_delete_by_priv_id(const char *pkgname, int priv_id);
+int notification_noti_delete_by_priv_id(const char *pkgname, int priv_id,
+					int *num_deleted);
+
+/* Return number of deleted rows, or negative notification_error_e.
+ * priv_ids of deleted rows are put in order in deleted_ids, which has
+ * room for n, unless it is NULL. */
+int notification_noti_delete_batch(const char *pkgname, const int *priv_ids,
+				   int n, int *deleted_ids);
 
 notification_error_e notification_noti_get_count(notification_type_e type,
 						 const char *pkgname,
 						 int group_id, int priv_id,
 						 int *count);
 
+/* fetch_option is bitwise OR of NOTIFICATION_FETCH_OPTION_XXX */
 notification_error_e notification_noti_get_grouping_list(notification_type_e type,
 							 int count,
+							 int fetch_option,
 							 notification_list_h *list);
 
 notification_error_e notification_noti_get_detail_list(const char *pkgname,
 						       int group_id,
 						       int priv_id, int count,
+						       int fetch_option,
 						       notification_list_h *list);
 
+notification_error_e notification_noti_get_grouping_list_page(notification_type_e type,
+							      int count,
+							      int fetch_option,
+							      notification_page_token_s *token,
+							      notification_list_h *list);
+
+/* count -1 is no limit. If page_rowid > 0, newest notification of each
+ * group older than page_rowid */
+notification_error_e notification_noti_cursor_open_grouping(notification_type_e type,
+							    int count,
+							    int page_rowid,
+							    int fetch_option,
+							    notification_cursor_h *cursor);
+
+notification_error_e notification_noti_cursor_open_detail(const char *pkgname,
+							   int group_id,
+							   int priv_id,
+							   int count,
+							   int fetch_option,
+							   notification_cursor_h *cursor);
+
+notification_error_e notification_noti_cursor_next(notification_cursor_h cursor,
+						   notification_h *noti);
+
+notification_error_e notification_noti_cursor_close(notification_cursor_h cursor);
+
 #endif				/* __NOTIFICATION_NOTI_H__ */
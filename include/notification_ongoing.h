@@ -33,4 +33,7 @@ notification_error_e notification_ongoing_update_size(const char *caller_pkgname
 notification_error_e notification_ongoing_update_content(const char *caller_pkgname,
 						      int priv_id, const char *content);
 
+/* Minimum interval of updates of a notification, 0 to send every update */
+notification_error_e notification_ongoing_set_interval(int msec);
+
 #endif				/* __NOTIFICATION_ONGOING_H__ */
@@ -0,0 +1,54 @@
+/*
+ *  libnotification
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Seungtaek Chung <seungtaek.chung@samsung.com>, Mi-Ju Lee <miju52.lee@samsung.com>, Xi Zhichan <zhichan.xi@samsung.com>, Youngsub Ko <ys4610.ko@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef __NOTIFICATION_SHM_H__
+#define __NOTIFICATION_SHM_H__
+
+#include <notification_error.h>
+#include <notification_type.h>
+
+/* Shared memory object of ongoing updates, created by viewer */
+#define NOTIFICATION_SHM_NAME "/notification_ongoing"
+
+/* Write update to ring of viewer. It fails when no viewer reads the
+ * ring. Caller sends it by D-Bus too, unless exclusive is set. */
+notification_error_e notification_shm_write(notification_ongoing_update_type_e type,
+					    const char *pkgname,
+					    int priv_id, double value,
+					    int *exclusive);
+
+/* Create ring and read it as viewer of this process, option is
+ * NOTIFICATION_ONGOING_CHANNEL_OPTION_XXX */
+notification_error_e notification_shm_reader_open(int option);
+
+/* Call cb for each new update, waiting up to timeout_msec for one,
+ * -1 to wait forever and 0 not to wait */
+notification_error_e notification_shm_reader_read(void (*cb)(void *data,
+							     notification_ongoing_update_type_e type,
+							     const char *pkgname,
+							     int priv_id,
+							     double value),
+						  void *data,
+						  int timeout_msec);
+
+notification_error_e notification_shm_reader_close(void);
+
+#endif				/* __NOTIFICATION_SHM_H__ */
@@ -238,11 +238,52 @@ enum _notificaton_display_applist {
 						/**< All display application */
 };
 
+/**
+ * @brief Enumeration for fetch option of notification list.
+ */
+enum _notification_fetch_option {
+	NOTIFICATION_FETCH_OPTION_NONE = 0x00000000,	/**< All data is read with list */
+	NOTIFICATION_FETCH_OPTION_SUMMARY = 0x00000001,	/**< Execute option and services are read from DB when they are used */
+	NOTIFICATION_FETCH_OPTION_ARENA = 0x00000002,	/**< Notifications of list are allocated together and freed at once by notification_free_list() */
+};
+
+/**
+ * @brief Enumeration for operation delivered to detailed changed callback.
+ */
+typedef enum _notification_op_type {
+	NOTIFICATION_OP_NONE = 0,	/**< Unknown change, reload list */
+	NOTIFICATION_OP_INSERT,	/**< Notifications are inserted */
+	NOTIFICATION_OP_UPDATE,	/**< Notifications are updated */
+	NOTIFICATION_OP_DELETE,	/**< Notifications are deleted */
+	NOTIFICATION_OP_DELETE_ALL,	/**< All notifications of type and package are deleted */
+} notification_op_type_e;
+
+/**
+ * @brief Enumeration for ongoing update delivered by shared memory channel.
+ */
+typedef enum _notification_ongoing_update_type {
+	NOTIFICATION_ONGOING_UPDATE_PROGRESS = 0,	/**< Progress is updated */
+	NOTIFICATION_ONGOING_UPDATE_SIZE,	/**< Size is updated */
+} notification_ongoing_update_type_e;
+
+/**
+ * @brief Enumeration for option of shared memory channel of ongoing updates.
+ */
+enum _notification_ongoing_channel_option {
+	NOTIFICATION_ONGOING_CHANNEL_OPTION_NONE = 0x00000000,	/**< Updates are sent by D-Bus signal too */
+	NOTIFICATION_ONGOING_CHANNEL_OPTION_EXCLUSIVE = 0x00000001,	/**< Updates are not sent by D-Bus signal, honored only for viewer running as root */
+};
+
 /**
  * @brief Notification handle
  */
 typedef struct _notification *notification_h;
 
+/**
+ * @brief Notification cursor handle
+ */
+typedef struct _notification_cursor *notification_cursor_h;
+
 /** 
  * @}
  */
@@ -58,30 +58,42 @@ fi
 
 if [ ! -f /opt/dbspace/.notification.db ]
 then
-	sqlite3 /opt/dbspace/.notification.db 'PRAGMA journal_mode = PERSIST;
+	sqlite3 /opt/dbspace/.notification.db 'PRAGMA journal_mode = WAL;
 		create 	table if not exists noti_list ( 
 			type INTEGER NOT NULL,
 			caller_pkgname TEXT NOT NULL,
 			launch_pkgname TEXT,
-			image_path TEXT,
+			image_path BLOB,
 			group_id INTEGER default 0,  
 			internal_group_id INTEGER default 0,  
 			priv_id INTERGER NOT NULL,  
 			title_key TEXT,
-			b_text TEXT,
-			b_key TEXT,
-			b_format_args TEXT,
+			text_title TEXT,
+			text_content TEXT,
+			text_content_off TEXT,
+			text_group_title TEXT,
+			text_group_content TEXT,
+			text_group_content_off TEXT,
+			key_title TEXT,
+			key_content TEXT,
+			key_content_off TEXT,
+			key_group_title TEXT,
+			key_group_content TEXT,
+			key_group_content_off TEXT,
+			b_text BLOB,
+			b_key BLOB,
+			b_format_args BLOB,
 			num_format_args INTEGER default 0,
 			text_domain TEXT,
 			text_dir TEXT,
 			time INTEGER default 0,  
 			insert_time INTEGER default 0,  
-			args TEXT,  
-			group_args TEXT,  
-			b_execute_option TEXT,
-			b_service_responding TEXT,
-			b_service_single_launch TEXT,
-			b_service_multi_launch TEXT,
+			args BLOB,  
+			group_args BLOB,  
+			b_execute_option BLOB,
+			b_service_responding BLOB,
+			b_service_single_launch BLOB,
+			b_service_multi_launch BLOB,
 			sound_type INTEGER default 0,
 			sound_path TEXT,
 			vibration_type INTEGER default 0,
@@ -130,13 +142,102 @@ then
 			rowid INTEGER PRIMARY KEY AUTOINCREMENT,	
 			UNIQUE (caller_pkgname, priv_id)  
 		); 
+		create table if not exists noti_count (
+			caller_pkgname TEXT NOT NULL,
+			group_id INTEGER NOT NULL,
+			internal_group_id INTEGER NOT NULL,
+			type INTEGER NOT NULL,
+			flag_simmode INTEGER NOT NULL,
+			count INTEGER NOT NULL default 0,
+			PRIMARY KEY (caller_pkgname, group_id, internal_group_id,
+				type, flag_simmode)
+		);
+		create trigger if not exists noti_count_insert
+			after insert on noti_list begin
+			insert or ignore into noti_count values (
+				new.caller_pkgname, new.group_id, new.internal_group_id,
+				new.type, new.flag_simmode, 0);
+			update noti_count set count = count + 1 where
+				caller_pkgname = new.caller_pkgname
+				and group_id = new.group_id
+				and internal_group_id = new.internal_group_id
+				and type = new.type
+				and flag_simmode = new.flag_simmode;
+		end;
+		create trigger if not exists noti_count_delete
+			after delete on noti_list begin
+			update noti_count set count = count - 1 where
+				caller_pkgname = old.caller_pkgname
+				and group_id = old.group_id
+				and internal_group_id = old.internal_group_id
+				and type = old.type
+				and flag_simmode = old.flag_simmode;
+			delete from noti_count where count <= 0 and
+				caller_pkgname = old.caller_pkgname
+				and group_id = old.group_id
+				and internal_group_id = old.internal_group_id
+				and type = old.type
+				and flag_simmode = old.flag_simmode;
+		end;
+		create trigger if not exists noti_count_update
+			after update of caller_pkgname, group_id, internal_group_id,
+				type, flag_simmode on noti_list begin
+			update noti_count set count = count - 1 where
+				caller_pkgname = old.caller_pkgname
+				and group_id = old.group_id
+				and internal_group_id = old.internal_group_id
+				and type = old.type
+				and flag_simmode = old.flag_simmode;
+			delete from noti_count where count <= 0 and
+				caller_pkgname = old.caller_pkgname
+				and group_id = old.group_id
+				and internal_group_id = old.internal_group_id
+				and type = old.type
+				and flag_simmode = old.flag_simmode;
+			insert or ignore into noti_count values (
+				new.caller_pkgname, new.group_id, new.internal_group_id,
+				new.type, new.flag_simmode, 0);
+			update noti_count set count = count + 1 where
+				caller_pkgname = new.caller_pkgname
+				and group_id = new.group_id
+				and internal_group_id = new.internal_group_id
+				and type = new.type
+				and flag_simmode = new.flag_simmode;
+		end;
+		create table if not exists noti_id_seq (
+			name TEXT NOT NULL,
+			seq INTEGER NOT NULL default 0,
+			PRIMARY KEY (name)
+		);
+		create index if not exists noti_list_pkg_group_idx
+			on noti_list (caller_pkgname, group_id, internal_group_id);
+		create index if not exists noti_list_pkg_internal_group_idx
+			on noti_list (caller_pkgname, internal_group_id);
+		create index if not exists noti_list_title_group_idx
+			on noti_list (title_key, group_id, internal_group_id);
+		create index if not exists noti_list_type_simmode_idx
+			on noti_list (type, flag_simmode);
+		create index if not exists noti_list_simmode_type_idx
+			on noti_list (flag_simmode, type);
+		create index if not exists noti_list_internal_group_idx
+			on noti_list (internal_group_id);
 	'
 fi
 
 chown :5000 /opt/dbspace/.notification.db
-chown :5000 /opt/dbspace/.notification.db-journal
 chmod 660 /opt/dbspace/.notification.db
-chmod 660 /opt/dbspace/.notification.db-journal
+
+# WAL files are kept by library, make them here with group of DB
+touch /opt/dbspace/.notification.db-wal /opt/dbspace/.notification.db-shm
+
+for f in /opt/dbspace/.notification.db-journal /opt/dbspace/.notification.db-wal /opt/dbspace/.notification.db-shm
+do
+	if [ -f $f ]
+	then
+		chown :5000 $f
+		chmod 660 $f
+	fi
+done
 
 %postun -p /sbin/ldconfig
 
@@ -25,6 +25,8 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <libintl.h>
+#include <pthread.h>
+#include <time.h>
 #include <dbus/dbus.h>
 #include <dbus/dbus-glib-lowlevel.h>
 
@@ -41,6 +43,9 @@
 #include <notification_noti.h>
 #include <notification_ongoing.h>
 #include <notification_group.h>
+#include <notification_ipc.h>
+#include <notification_shm.h>
+#include <notification_arena.h>
 
 typedef struct _notification_cb_list notification_cb_list_s;
 
@@ -49,19 +54,38 @@ struct _notification_cb_list {
 	notification_cb_list_s *next;
 
 	void (*changed_cb) (void *data, notification_type_e type);
+	void (*detailed_changed_cb) (void *data, notification_op_type_e op,
+				     const char *pkgname,
+				     notification_type_e type,
+				     const int *priv_ids, int num_priv_ids);
+	void *data;
+
+	/* Filter of detailed_changed_cb, also installed as match rules */
+	int filtered;
+	char *filter_pkgname;	/* NULL for any package */
+	notification_type_e filter_type;	/* NOTIFICATION_TYPE_NONE for any */
+	int filter_applist;	/* NOTIFICATION_DISPLAY_APP_ALL for any */
+};
+
+typedef struct _notification_badge_cb_list notification_badge_cb_list_s;
+
+struct _notification_badge_cb_list {
+	notification_badge_cb_list_s *next;
+
+	void (*changed_cb) (void *data, const char *pkgname, int group_id,
+			    int count);
 	void *data;
 };
 
 static notification_cb_list_s *g_notification_cb_list = NULL;
+static notification_badge_cb_list_s *g_notification_badge_cb_list = NULL;
 static DBusConnection *g_dbus_handle;
 
 #define NOTI_PKGNAME_LEN	512
-#define NOTI_CHANGED_NOTI	"notification_noti_changed"
-#define NOTI_CHANGED_ONGOING	"notification_ontoing_changed"
-
-#define NOTI_DBUS_BUS_NAME 	"org.tizen.libnotification"
-#define NOTI_DBUS_PATH 		"/org/tizen/libnotification"
-#define NOTI_DBUS_INTERFACE 	"org.tizen.libnotification.signal"
+/* Package name arg of match rule, each char may be quoted to 4 */
+#define NOTI_PKGNAME_ARG_LEN	(NOTI_PKGNAME_LEN * 4 + 16)
+/* Args of match rule: package name, type and an applist bit */
+#define NOTI_MATCH_ARGS_LEN	(NOTI_PKGNAME_ARG_LEN + 64)
 
 static char *_notification_get_pkgname_by_pid(void)
 {
@@ -155,6 +179,17 @@ static char *_notification_get_name(const char *package)
 	return name;
 }
 
+static void _notification_decode_execute_option(notification_h noti)
+{
+	notification_noti_decode_bundle(noti, NOTIFICATION_BUNDLE_EXECUTE_OPTION);
+	notification_noti_decode_bundle(noti,
+					NOTIFICATION_BUNDLE_SERVICE_RESPONDING);
+	notification_noti_decode_bundle(noti,
+					NOTIFICATION_BUNDLE_SERVICE_SINGLE_LAUNCH);
+	notification_noti_decode_bundle(noti,
+					NOTIFICATION_BUNDLE_SERVICE_MULTI_LAUNCH);
+}
+
 static void _notification_get_text_domain(notification_h noti)
 {
 	if (noti->domain != NULL) {
@@ -166,14 +201,92 @@ static void _notification_get_text_domain(notification_h noti)
 	}
 }
 
-static void _notification_chagned_noti_cb(void *data)
+/* Match rules of other callbacks of this process let signals of
+ * other filters in, check filter of callback again */
+static int _notification_cb_filter_match(notification_cb_list_s *noti_cb_list,
+					 const char *pkgname,
+					 notification_type_e type,
+					 int applist)
+{
+	/* Unknown package or type of signal matches any filter */
+	if (pkgname != NULL && noti_cb_list->filter_pkgname != NULL
+	    && strcmp(pkgname, noti_cb_list->filter_pkgname) != 0) {
+		return 0;
+	}
+
+	if (type != NOTIFICATION_TYPE_NONE
+	    && noti_cb_list->filter_type != NOTIFICATION_TYPE_NONE
+	    && type != noti_cb_list->filter_type) {
+		return 0;
+	}
+
+	return (applist & noti_cb_list->filter_applist) != 0;
+}
+
+static void _notification_chagned_noti_cb(DBusMessage *msg)
 {
 	notification_cb_list_s *noti_cb_list = NULL;
+	DBusError err;
+	dbus_int32_t op = NOTIFICATION_OP_NONE;
+	dbus_int32_t type = NOTIFICATION_TYPE_NONE;
+	const char *pkgname = NULL;
+	dbus_int32_t *priv_ids = NULL;
+	int num_priv_ids = 0;
+	int applist_bits[NOTI_CHANGED_APPLIST_NUM] = NOTI_CHANGED_APPLIST;
+	const char *applist_args[NOTI_CHANGED_APPLIST_NUM] = { NULL, };
+	const char *type_arg = NULL;
+	int applist = NOTIFICATION_DISPLAY_APP_ALL;
+	int i = 0;
 
 	if (g_notification_cb_list == NULL) {
 		return;
 	}
 
+	dbus_error_init(&err);
+	if (dbus_message_get_args(msg, &err,
+				  DBUS_TYPE_INT32, &op,
+				  DBUS_TYPE_STRING, &pkgname,
+				  DBUS_TYPE_INT32, &type,
+				  DBUS_TYPE_ARRAY, DBUS_TYPE_INT32,
+				  &priv_ids, &num_priv_ids,
+				  DBUS_TYPE_STRING, &type_arg,
+				  DBUS_TYPE_STRING, &applist_args[0],
+				  DBUS_TYPE_STRING, &applist_args[1],
+				  DBUS_TYPE_STRING, &applist_args[2],
+				  DBUS_TYPE_STRING, &applist_args[3],
+				  DBUS_TYPE_INVALID)) {
+		applist = 0;
+		for (i = 0; i < NOTI_CHANGED_APPLIST_NUM; i++) {
+			if (strcmp(applist_args[i], "1") == 0) {
+				applist |= applist_bits[i];
+			}
+		}
+	} else {
+		dbus_error_free(&err);
+		dbus_error_init(&err);
+
+		/* Signal of older library has less args or no args,
+		 * it is a change of anything */
+		if (!dbus_message_get_args(msg, &err,
+					   DBUS_TYPE_INT32, &op,
+					   DBUS_TYPE_STRING, &pkgname,
+					   DBUS_TYPE_INT32, &type,
+					   DBUS_TYPE_ARRAY, DBUS_TYPE_INT32,
+					   &priv_ids, &num_priv_ids,
+					   DBUS_TYPE_INVALID)) {
+			dbus_error_free(&err);
+			op = NOTIFICATION_OP_NONE;
+			pkgname = NULL;
+			type = NOTIFICATION_TYPE_NONE;
+			priv_ids = NULL;
+			num_priv_ids = 0;
+		}
+	}
+
+	if (pkgname != NULL && pkgname[0] == '\0') {
+		pkgname = NULL;
+	}
+
 	noti_cb_list = g_notification_cb_list;
 
 	while (noti_cb_list->prev != NULL) {
@@ -186,10 +299,50 @@ static void _notification_chagned_noti_cb(void *data)
 						 NOTIFICATION_TYPE_NOTI);
 		}
 
+		if (noti_cb_list->detailed_changed_cb
+		    && (!noti_cb_list->filtered
+			|| _notification_cb_filter_match(noti_cb_list, pkgname,
+							 type, applist))) {
+			noti_cb_list->detailed_changed_cb(noti_cb_list->data,
+							  op, pkgname, type,
+							  priv_ids,
+							  num_priv_ids);
+		}
+
 		noti_cb_list = noti_cb_list->next;
 	}
 }
 
+static void _notification_changed_badge_cb(DBusMessage *msg)
+{
+	notification_badge_cb_list_s *badge_cb_list = NULL;
+	DBusError err;
+	const char *pkgname = NULL;
+	dbus_int32_t group_id = 0;
+	dbus_int32_t count = 0;
+
+	dbus_error_init(&err);
+	if (!dbus_message_get_args(msg, &err,
+				   DBUS_TYPE_STRING, &pkgname,
+				   DBUS_TYPE_INT32, &group_id,
+				   DBUS_TYPE_INT32, &count,
+				   DBUS_TYPE_INVALID)) {
+		NOTIFICATION_ERR("fail to get badge args : %s", err.message);
+		dbus_error_free(&err);
+		return;
+	}
+
+	badge_cb_list = g_notification_badge_cb_list;
+	while (badge_cb_list != NULL) {
+		if (badge_cb_list->changed_cb) {
+			badge_cb_list->changed_cb(badge_cb_list->data, pkgname,
+						  group_id, count);
+		}
+
+		badge_cb_list = badge_cb_list->next;
+	}
+}
+
 #if 0
 static void _notification_chagned_ongoing_cb(void *data)
 {
@@ -216,52 +369,427 @@ static void _notification_chagned_ongoing_cb(void *data)
 }
 #endif
 
-static void _notification_changed(const char *type)
+/* Send NOTI_CHANGED_NOTI with op, pkgname, type, priv_ids and
+ * display applist of change */
+static void _notification_changed_send(notification_op_type_e op,
+				  const char *pkgname,
+				  notification_type_e type,
+				  const int *priv_ids, int num_priv_ids,
+				  int applist)
 {
-	DBusConnection *connection = NULL;
 	DBusMessage *message = NULL;
-	DBusError err;
 	dbus_bool_t ret;
+	dbus_int32_t op_arg = op;
+	dbus_int32_t type_arg = type;
+	const char *pkgname_arg = pkgname ? pkgname : "";
+	int applist_bits[NOTI_CHANGED_APPLIST_NUM] = NOTI_CHANGED_APPLIST;
+	const char *applist_args[NOTI_CHANGED_APPLIST_NUM] = { NULL, };
+	char type_buf[16] = { 0, };
+	const char *type_str = type_buf;
+	int i = 0;
 
-	if (!type) {
-		NOTIFICATION_ERR("type is NULL");
-		return;
-	}
-
-	dbus_error_init(&err);
-	connection = dbus_bus_get(DBUS_BUS_SYSTEM, &err);
-	if (!connection) {
-		NOTIFICATION_ERR("Fail to dbus_bus_get : %s", err.message);
-		return;
+	snprintf(type_buf, sizeof(type_buf), "%d", type);
+	for (i = 0; i < NOTI_CHANGED_APPLIST_NUM; i++) {
+		applist_args[i] = (applist & applist_bits[i]) ? "1" : "0";
 	}
 
 	message = dbus_message_new_signal(NOTI_DBUS_PATH,
 				NOTI_DBUS_INTERFACE,
-				type);
+				NOTI_CHANGED_NOTI);
 
 	if (!message) {
 		NOTIFICATION_ERR("fail to create dbus message");
 		goto release_n_return;
 	}
 
-	ret = dbus_connection_send(connection, message, NULL);
+	if (priv_ids == NULL) {
+		num_priv_ids = 0;
+	}
+
+	ret = dbus_message_append_args(message,
+				       DBUS_TYPE_INT32, &op_arg,
+				       DBUS_TYPE_STRING, &pkgname_arg,
+				       DBUS_TYPE_INT32, &type_arg,
+				       DBUS_TYPE_ARRAY, DBUS_TYPE_INT32,
+				       &priv_ids, num_priv_ids,
+				       DBUS_TYPE_STRING, &type_str,
+				       DBUS_TYPE_STRING, &applist_args[0],
+				       DBUS_TYPE_STRING, &applist_args[1],
+				       DBUS_TYPE_STRING, &applist_args[2],
+				       DBUS_TYPE_STRING, &applist_args[3],
+				       DBUS_TYPE_INVALID);
 	if (!ret) {
-		NOTIFICATION_ERR("fail to send dbus message : %s", type);
+		NOTIFICATION_ERR("fail to append dbus args");
 		goto release_n_return;
 	}
 
-	dbus_connection_flush(connection);
-	
-	NOTIFICATION_DBG("success to emit signal [%s]", type);
+	/* Queued on shared connection, not waiting for bus */
+	if (notification_ipc_send(message) != NOTIFICATION_ERROR_NONE) {
+		NOTIFICATION_ERR("fail to send dbus message : %d", op);
+		goto release_n_return;
+	}
 
-release_n_return:
-	dbus_error_free(&err);
+	NOTIFICATION_DBG("success to emit signal [%d] %s(%d)", op,
+			 pkgname_arg, num_priv_ids);
 
+release_n_return:
 	if (message)
 		dbus_message_unref(message);
+}
+
+/* Change of a priv_id, or whole change for NOTIFICATION_OP_NONE and
+ * NOTIFICATION_OP_DELETE_ALL, waiting for end of coalescing window */
+typedef struct _notification_changed_item {
+	notification_op_type_e op;
+	char *pkgname;
+	notification_type_e type;
+	int priv_id;
+	int applist;		/* Display applist of all merged changes */
+	int sent;		/* Sent with other item of flush */
+} notification_changed_item_s;
+
+static pthread_mutex_t g_changed_lock = PTHREAD_MUTEX_INITIALIZER;
+static int g_changed_window = 0;	/* msec, 0 if changes are sent at once */
+static pthread_cond_t g_changed_cond = PTHREAD_COND_INITIALIZER;
+static long long g_changed_due = 0;	/* msec of monotonic clock, 0 if none */
+static int g_changed_thread = 0;
+static notification_changed_item_s *g_changed_items = NULL;
+static int g_changed_num = 0;
+static int g_changed_size = 0;
+static pthread_once_t g_changed_once = PTHREAD_ONCE_INIT;
+
+static int _notification_changed_same_pkgname(const char *a, const char *b)
+{
+	if (a == NULL || b == NULL) {
+		return a == b;
+	}
+
+	return strcmp(a, b) == 0;
+}
+
+static void _notification_changed_remove(int i)
+{
+	free(g_changed_items[i].pkgname);
+
+	g_changed_num--;
+	memmove(&g_changed_items[i], &g_changed_items[i + 1],
+		sizeof(notification_changed_item_s) * (g_changed_num - i));
+}
+
+static void _notification_changed_append(notification_op_type_e op,
+					 const char *pkgname,
+					 notification_type_e type, int priv_id,
+					 int applist)
+{
+	notification_changed_item_s *items = NULL;
+	int size = 0;
+
+	if (g_changed_num == g_changed_size) {
+		size = g_changed_size ? g_changed_size * 2 : 16;
+		items = realloc(g_changed_items,
+				sizeof(notification_changed_item_s) * size);
+		if (items == NULL) {
+			NOTIFICATION_ERR("No memory for changed item");
+			return;
+		}
+
+		g_changed_items = items;
+		g_changed_size = size;
+	}
+
+	g_changed_items[g_changed_num].op = op;
+	g_changed_items[g_changed_num].pkgname =
+	    pkgname ? strdup(pkgname) : NULL;
+	g_changed_items[g_changed_num].type = type;
+	g_changed_items[g_changed_num].priv_id = priv_id;
+	g_changed_items[g_changed_num].applist = applist;
+	g_changed_items[g_changed_num].sent = 0;
+	g_changed_num++;
+}
+
+/* Merge change of a priv_id into pending change of the same priv_id */
+static void _notification_changed_merge(notification_op_type_e op,
+					const char *pkgname,
+					notification_type_e type, int priv_id,
+					int applist)
+{
+	notification_changed_item_s *item = NULL;
+	int i = 0;
+
+	for (i = g_changed_num - 1; i >= 0; i--) {
+		item = &g_changed_items[i];
+		if (item->op == NOTIFICATION_OP_NONE
+		    || item->op == NOTIFICATION_OP_DELETE_ALL) {
+			break;
+		}
+
+		if (item->priv_id != priv_id
+		    || !_notification_changed_same_pkgname(item->pkgname,
+							   pkgname)) {
+			continue;
+		}
+
+		/* Displays of old and new state are told of it */
+		item->applist |= applist;
+
+		if (item->op == NOTIFICATION_OP_INSERT) {
+			if (op == NOTIFICATION_OP_DELETE) {
+				/* Inserted and deleted, nothing to send */
+				_notification_changed_remove(i);
+			} else {
+				item->type = type;
+			}
+		} else if (item->op == NOTIFICATION_OP_DELETE
+			   && op == NOTIFICATION_OP_INSERT) {
+			/* Deleted and inserted again with same priv_id */
+			item->op = NOTIFICATION_OP_UPDATE;
+			item->type = type;
+		} else {
+			item->op = op;
+			item->type = type;
+		}
+
+		return;
+	}
+
+	_notification_changed_append(op, pkgname, type, priv_id, applist);
+}
+
+static long long _notification_changed_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void _notification_changed_flush(void)
+{
+	notification_changed_item_s *items = NULL;
+	int *priv_ids = NULL;
+	int num = 0;
+	int num_priv_ids = 0;
+	int applist = 0;
+	int i = 0;
+	int j = 0;
+
+	pthread_mutex_lock(&g_changed_lock);
+	items = g_changed_items;
+	num = g_changed_num;
+	g_changed_items = NULL;
+	g_changed_num = 0;
+	g_changed_size = 0;
+	g_changed_due = 0;
+	pthread_mutex_unlock(&g_changed_lock);
+
+	if (num > 0) {
+		priv_ids = malloc(sizeof(int) * num);
+	}
+
+	/* One signal for each op, pkgname and type, in order of first change.
+	 * Each priv_id has one item after merge, so order of priv_ids is
+	 * not significant. */
+	for (i = 0; i < num; i++) {
+		if (items[i].sent) {
+			continue;
+		}
+
+		if (items[i].op == NOTIFICATION_OP_NONE
+		    || items[i].op == NOTIFICATION_OP_DELETE_ALL
+		    || priv_ids == NULL) {
+			_notification_changed_send(items[i].op,
+						   items[i].pkgname,
+						   items[i].type,
+						   priv_ids ? NULL : &items[i].priv_id,
+						   priv_ids ? 0 : 1,
+						   items[i].applist);
+			continue;
+		}
+
+		num_priv_ids = 0;
+		applist = 0;
+		for (j = i; j < num; j++) {
+			if (items[j].op == items[i].op
+			    && items[j].type == items[i].type
+			    && _notification_changed_same_pkgname(items[j].pkgname,
+								  items[i].pkgname)) {
+				priv_ids[num_priv_ids++] = items[j].priv_id;
+				applist |= items[j].applist;
+				items[j].sent = 1;
+			}
+		}
+
+		_notification_changed_send(items[i].op, items[i].pkgname,
+					   items[i].type, priv_ids,
+					   num_priv_ids, applist);
+	}
 
-	if (connection)
-		dbus_connection_unref(connection);
+	for (i = 0; i < num; i++) {
+		free(items[i].pkgname);
+	}
+	free(items);
+	free(priv_ids);
+}
+
+/* Send pending changes at end of window, without main loop of caller */
+static void *_notification_changed_flush_thread(void *data)
+{
+	struct timespec ts;
+	long long wait = 0;
+
+	pthread_mutex_lock(&g_changed_lock);
+
+	while (1) {
+		if (g_changed_due == 0) {
+			pthread_cond_wait(&g_changed_cond, &g_changed_lock);
+			continue;
+		}
+
+		wait = g_changed_due - _notification_changed_now();
+		if (wait <= 0) {
+			pthread_mutex_unlock(&g_changed_lock);
+			_notification_changed_flush();
+			pthread_mutex_lock(&g_changed_lock);
+			continue;
+		}
+
+		clock_gettime(CLOCK_REALTIME, &ts);
+		ts.tv_sec += wait / 1000;
+		ts.tv_nsec += (wait % 1000) * 1000000;
+		if (ts.tv_nsec >= 1000000000) {
+			ts.tv_sec++;
+			ts.tv_nsec -= 1000000000;
+		}
+
+		pthread_cond_timedwait(&g_changed_cond, &g_changed_lock, &ts);
+	}
+
+	return NULL;
+}
+
+static void _notification_changed_exit(void)
+{
+	/* Send changes still in window and write them before exit */
+	_notification_changed_flush();
+	notification_ipc_flush();
+}
+
+static void _notification_changed_atfork_prepare(void)
+{
+	pthread_mutex_lock(&g_changed_lock);
+}
+
+static void _notification_changed_atfork_parent(void)
+{
+	pthread_mutex_unlock(&g_changed_lock);
+}
+
+static void _notification_changed_atfork_child(void)
+{
+	/* Flush thread is not running in child, and pending changes are
+	 * the parent's to send. Drop them, child starts its own thread. */
+	while (g_changed_num > 0) {
+		_notification_changed_remove(g_changed_num - 1);
+	}
+	g_changed_due = 0;
+	g_changed_thread = 0;
+	pthread_cond_init(&g_changed_cond, NULL);
+
+	pthread_mutex_unlock(&g_changed_lock);
+}
+
+static void _notification_changed_init_once(void)
+{
+	pthread_atfork(_notification_changed_atfork_prepare,
+		       _notification_changed_atfork_parent,
+		       _notification_changed_atfork_child);
+
+	atexit(_notification_changed_exit);
+}
+
+/* Send change at once, or merge it into pending changes if coalescing
+ * window is set. Change of no priv_id is not sent. applist is display
+ * applist of changed notifications, NOTIFICATION_DISPLAY_APP_ALL if it
+ * is not known. */
+static void _notification_changed(notification_op_type_e op,
+				  const char *pkgname,
+				  notification_type_e type,
+				  const int *priv_ids, int num_priv_ids,
+				  int applist)
+{
+	pthread_t thread;
+	int i = 0;
+
+	if ((op == NOTIFICATION_OP_INSERT || op == NOTIFICATION_OP_UPDATE
+	     || op == NOTIFICATION_OP_DELETE)
+	    && (priv_ids == NULL || num_priv_ids <= 0)) {
+		return;
+	}
+
+	pthread_once(&g_changed_once, _notification_changed_init_once);
+
+	pthread_mutex_lock(&g_changed_lock);
+
+	if (g_changed_window <= 0) {
+		pthread_mutex_unlock(&g_changed_lock);
+		_notification_changed_send(op, pkgname, type, priv_ids,
+					   num_priv_ids, applist);
+		return;
+	}
+
+	if (op == NOTIFICATION_OP_NONE) {
+		/* Subscribers reload all, pending changes are in it */
+		while (g_changed_num > 0) {
+			_notification_changed_remove(g_changed_num - 1);
+		}
+		_notification_changed_append(op, NULL, NOTIFICATION_TYPE_NONE, 0,
+					     NOTIFICATION_DISPLAY_APP_ALL);
+	} else if (op == NOTIFICATION_OP_DELETE_ALL) {
+		/* Pending changes of deleted notifications are not sent */
+		for (i = g_changed_num - 1; i >= 0; i--) {
+			if (g_changed_items[i].op == NOTIFICATION_OP_NONE) {
+				break;
+			}
+
+			if ((pkgname == NULL
+			     || _notification_changed_same_pkgname(g_changed_items[i].pkgname,
+								   pkgname))
+			    && (type == NOTIFICATION_TYPE_NONE
+				|| g_changed_items[i].type == type)) {
+				_notification_changed_remove(i);
+			}
+		}
+		_notification_changed_append(op, pkgname, type, 0,
+					     NOTIFICATION_DISPLAY_APP_ALL);
+	} else {
+		for (i = 0; i < num_priv_ids; i++) {
+			_notification_changed_merge(op, pkgname, type,
+						    priv_ids[i], applist);
+		}
+	}
+
+	if (g_changed_due == 0 && g_changed_num > 0) {
+		if (g_changed_thread == 0) {
+			if (pthread_create(&thread, NULL,
+					   _notification_changed_flush_thread,
+					   NULL) != 0) {
+				/* Nobody flushes it, send now */
+				NOTIFICATION_ERR("Fail to create flush thread");
+				pthread_mutex_unlock(&g_changed_lock);
+				_notification_changed_flush();
+				return;
+			}
+
+			pthread_detach(thread);
+			g_changed_thread = 1;
+		}
+
+		g_changed_due = _notification_changed_now() + g_changed_window;
+		pthread_cond_signal(&g_changed_cond);
+	}
+
+	pthread_mutex_unlock(&g_changed_lock);
 }
 
 static DBusHandlerResult _dbus_signal_filter(DBusConnection *conn,
@@ -279,7 +807,12 @@ static DBusHandlerResult _dbus_signal_filter(DBusConnection *conn,
 
 	switch (dbus_message_get_type(msg)) {
 		case DBUS_MESSAGE_TYPE_SIGNAL:
-			_notification_chagned_noti_cb(NULL);	
+			if (dbus_message_is_signal(msg, NOTI_DBUS_INTERFACE,
+						   NOTI_CHANGED_BADGE)) {
+				_notification_changed_badge_cb(msg);
+			} else {
+				_notification_chagned_noti_cb(msg);
+			}
 			return DBUS_HANDLER_RESULT_HANDLED;
 		default:
 			break;
@@ -289,24 +822,15 @@ static DBusHandlerResult _dbus_signal_filter(DBusConnection *conn,
 
 static DBusConnection *_noti_changed_monitor_init()
 {
-	DBusError err;
 	DBusConnection *conn = NULL;
-	char rule[1024];
 
-	dbus_error_init(&err);
-	conn = dbus_bus_get_private(DBUS_BUS_SYSTEM, &err);
+	conn = notification_ipc_open();
 	if (!conn) {
 		printf("fail to get bus\n");
 		return NULL;
 	}
 	dbus_connection_setup_with_g_main(conn, NULL);
-	snprintf(rule, 1024, 
-		"path='%s',type='signal',interface='%s',member='%s'",
-		NOTI_DBUS_PATH, 
-		NOTI_DBUS_INTERFACE,
-		NOTI_CHANGED_NOTI);
 
-	dbus_bus_add_match(conn, rule, &err);
 	if (dbus_connection_add_filter(conn,_dbus_signal_filter, 
 					NULL, NULL) == FALSE) {
 		NOTIFICATION_ERR("fail to dbus_connection_add_filter");
@@ -318,21 +842,134 @@ static DBusConnection *_noti_changed_monitor_init()
 	return conn;
 }
 
-static void _noti_chanaged_monitor_fini()
+/* Receive member signal with args matching while a callback of it is
+ * registered. Bus counts same rules added by callbacks. */
+static void _noti_changed_monitor_match(const char *member, const char *args,
+					int add)
 {
 	DBusConnection *conn = g_dbus_handle;
-	char rule[1024];
+	char rule[256 + NOTI_MATCH_ARGS_LEN];
 
 	if (!conn)
 		return;
-	dbus_connection_remove_filter(conn, _dbus_signal_filter, NULL);
 
-	snprintf(rule, 1024, 
-		"path='%s',type='signal',interface='%s',member='%s'",
+	snprintf(rule, sizeof(rule), 
+		"path='%s',type='signal',interface='%s',member='%s'%s",
 		NOTI_DBUS_PATH, 
 		NOTI_DBUS_INTERFACE,
-		NOTI_CHANGED_NOTI);
-	dbus_bus_remove_match(conn, rule, NULL);
+		member, args);
+
+	if (add)
+		dbus_bus_add_match(conn, rule, NULL);
+	else
+		dbus_bus_remove_match(conn, rule, NULL);
+}
+
+/* Quote value of match rule arg. In quotes every char but ' stands for
+ * itself, ' ends the quoted part, so it is put as \' out of quotes. */
+static void _noti_changed_monitor_quote(char *buf, const char *value)
+{
+	*buf++ = '\'';
+	while (*value != '\0') {
+		if (*value == '\'') {
+			memcpy(buf, "'\\''", 4);
+			buf += 4;
+		} else {
+			*buf++ = *value;
+		}
+		value++;
+	}
+	*buf++ = '\'';
+	*buf = '\0';
+}
+
+/* Rules of filter of callback, so bus drops signals of other packages,
+ * types and displays. A signal of unknown package or type matches any
+ * filter and a rule is added for each applist bit, so it takes up to
+ * 2 * 2 * NOTI_CHANGED_APPLIST_NUM rules. */
+static void _noti_changed_monitor_filter(notification_cb_list_s *noti_cb_list,
+					 int add)
+{
+	int applist_bits[NOTI_CHANGED_APPLIST_NUM] = NOTI_CHANGED_APPLIST;
+	char pkgname_args[2][NOTI_PKGNAME_ARG_LEN];
+	char pkgname_quoted[NOTI_PKGNAME_LEN * 4 + 3];
+	char type_args[2][32];
+	char applist_args[NOTI_CHANGED_APPLIST_NUM][32];
+	char args[sizeof(pkgname_args[0]) + sizeof(type_args[0])
+		  + sizeof(applist_args[0])];
+	int num_pkgname_args = 1;
+	int num_type_args = 1;
+	int num_applist_args = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+
+	if (!noti_cb_list->filtered) {
+		_noti_changed_monitor_match(NOTI_CHANGED_NOTI, "", add);
+		return;
+	}
+
+	pkgname_args[0][0] = '\0';
+	if (noti_cb_list->filter_pkgname != NULL) {
+		_noti_changed_monitor_quote(pkgname_quoted,
+					    noti_cb_list->filter_pkgname);
+		snprintf(pkgname_args[0], sizeof(pkgname_args[0]),
+			 ",arg%d=%s", NOTI_CHANGED_ARG_PKGNAME,
+			 pkgname_quoted);
+		snprintf(pkgname_args[1], sizeof(pkgname_args[1]),
+			 ",arg%d=''", NOTI_CHANGED_ARG_PKGNAME);
+		num_pkgname_args = 2;
+	}
+
+	type_args[0][0] = '\0';
+	if (noti_cb_list->filter_type != NOTIFICATION_TYPE_NONE) {
+		snprintf(type_args[0], sizeof(type_args[0]), ",arg%d='%d'",
+			 NOTI_CHANGED_ARG_TYPE, noti_cb_list->filter_type);
+		snprintf(type_args[1], sizeof(type_args[1]), ",arg%d='%d'",
+			 NOTI_CHANGED_ARG_TYPE, NOTIFICATION_TYPE_NONE);
+		num_type_args = 2;
+	}
+
+	if (noti_cb_list->filter_applist == NOTIFICATION_DISPLAY_APP_ALL) {
+		applist_args[0][0] = '\0';
+		num_applist_args = 1;
+	} else {
+		for (i = 0; i < NOTI_CHANGED_APPLIST_NUM; i++) {
+			if (noti_cb_list->filter_applist & applist_bits[i]) {
+				snprintf(applist_args[num_applist_args++],
+					 sizeof(applist_args[0]),
+					 ",arg%d='1'",
+					 NOTI_CHANGED_ARG_APPLIST + i);
+			}
+		}
+	}
+
+	for (i = 0; i < num_pkgname_args; i++) {
+		for (j = 0; j < num_type_args; j++) {
+			for (k = 0; k < num_applist_args; k++) {
+				snprintf(args, sizeof(args), "%s%s%s",
+					 pkgname_args[i], type_args[j],
+					 applist_args[k]);
+				_noti_changed_monitor_match(NOTI_CHANGED_NOTI,
+							    args, add);
+			}
+		}
+	}
+}
+
+static void _noti_chanaged_monitor_fini()
+{
+	DBusConnection *conn = g_dbus_handle;
+
+	if (!conn)
+		return;
+
+	/* Still used by other callbacks */
+	if (g_notification_cb_list != NULL
+	    || g_notification_badge_cb_list != NULL)
+		return;
+
+	dbus_connection_remove_filter(conn, _dbus_signal_filter, NULL);
 
 	dbus_connection_close(conn);
 	g_dbus_handle = NULL;
@@ -371,14 +1008,30 @@ EXPORT_API notification_error_e notification_get_icon(notification_h noti,
 	return ret_err;
 }
 
+/* Replace string of text, key or image slot, NULL clears it */
+static notification_error_e _notification_set_slot(notification_h noti,
+						   char **slot,
+						   const char *value)
+{
+	char *new_value = NULL;
+
+	if (value != NULL) {
+		new_value = strdup(value);
+		if (new_value == NULL) {
+			return NOTIFICATION_ERROR_NO_MEMORY;
+		}
+	}
+
+	notification_arena_free(noti->arena, *slot);
+	*slot = new_value;
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
 EXPORT_API notification_error_e notification_set_image(notification_h noti,
 						       notification_image_type_e type,
 						       const char *image_path)
 {
-	bundle *b = NULL;
-	char buf_key[32] = { 0, };
-	const char *ret_val = NULL;
-
 	/* Check noti and image_path are valid data */
 	if (noti == NULL || image_path == NULL) {
 		return NOTIFICATION_ERROR_INVALID_DATA;
@@ -390,47 +1043,18 @@ EXPORT_API notification_error_e notification_set_image(notification_h noti,
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
-	/* Check image path bundle is exist */
-	if (noti->b_image_path) {
-		/* If image path bundle is exist, store local bundle value */
-		b = noti->b_image_path;
-
-		/* Set image type to key as char string type */
-		snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-		/* Get value using key */
-		ret_val = bundle_get_val(b, buf_key);
-		if (ret_val != NULL) {
-			/* If key is exist, remove this value to store new image path */
-			bundle_del(b, buf_key);
-		}
-
-		/* Add new image path with type key */
-		bundle_add(b, buf_key, image_path);
-	} else {
-		/* If image path bundle is not exist, create new one */
-		b = bundle_create();
-
-		/* Set image type to key as char string type */
-		snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-		/* Add new image path with type key */
-		bundle_add(b, buf_key, image_path);
-
-		/* Save to image path bundle */
-		noti->b_image_path = b;
-	}
+	/* Decode image path bundle read from DB */
+	notification_noti_decode_bundle(noti, NOTIFICATION_BUNDLE_IMAGE_PATH);
 
-	return NOTIFICATION_ERROR_NONE;
+	/* Replace image path of type */
+	return _notification_set_slot(noti, &noti->image_path[type],
+				      image_path);
 }
 
 EXPORT_API notification_error_e notification_get_image(notification_h noti,
 						       notification_image_type_e type,
 						       char **image_path)
 {
-	bundle *b = NULL;
-	char buf_key[32] = { 0, };
-	const char *ret_val = NULL;
 	const char *pkgname = NULL;
 
 	/* Check noti and image_path is valid data */
@@ -444,22 +1068,11 @@ EXPORT_API notification_error_e notification_get_image(notification_h noti,
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
-	/* Check image path bundle exist */
-	if (noti->b_image_path) {
-		/* If image path bundle exist, store local bundle data */
-		b = noti->b_image_path;
+	/* Decode image path bundle read from DB */
+	notification_noti_decode_bundle(noti, NOTIFICATION_BUNDLE_IMAGE_PATH);
 
-		/* Set image type to key as char string type */
-		snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-		/* Get value of key */
-		ret_val = bundle_get_val(b, buf_key);
-
-		*image_path = (char *)ret_val;
-	} else {
-		/* If image path bundle does not exist, image path is NULL */
-		*image_path = NULL;
-	}
+	/* Image path of type, NULL if it is not set */
+	*image_path = noti->image_path[type];
 
 	/* If image path is NULL and type is ICON, icon path set from AIL */
 	/* order : user icon -> launch_pkgname icon -> caller_pkgname icon -> service app icon */
@@ -483,6 +1096,10 @@ EXPORT_API notification_error_e notification_get_image(notification_h noti,
 			}
 
 			/* If app icon path is NULL, get image path using service data */
+			if (noti->app_icon_path == NULL) {
+				notification_noti_decode_bundle(noti,
+								NOTIFICATION_BUNDLE_SERVICE_SINGLE_LAUNCH);
+			}
 			if (noti->app_icon_path == NULL
 			    && noti->b_service_single_launch != NULL) {
 				pkgname =
@@ -639,19 +1256,16 @@ EXPORT_API notification_error_e notification_set_text(notification_h noti,
 						      const char *key,
 						      int args_type, ...)
 {
-	bundle *b = NULL;
-	char buf_key[32] = { 0, };
 	char buf_val[1024] = { 0, };
-	const char *ret_val = NULL;
 	va_list var_args;
 	notification_variable_type_e var_type;
+	notification_format_arg_s *args = NULL;
+	notification_format_arg_s *new_args = NULL;
+	int size_args = 0;
 	int num_args = 0;
+	int i = 0;
 	notification_error_e noti_err = NOTIFICATION_ERROR_NONE;
-	int var_value_int = 0;
-	double var_value_double = 0.0;
 	char *var_value_string = NULL;
-	notification_count_pos_type_e var_value_count =
-	    NOTIFICATION_COUNT_POS_NONE;
 
 	/* Check noti is valid data */
 	if (noti == NULL) {
@@ -664,117 +1278,27 @@ EXPORT_API notification_error_e notification_set_text(notification_h noti,
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
-	/* Check text bundle exist */
-	if (text != NULL) {
-		if (noti->b_text != NULL) {
-			/* If text bundle exist, store local bundle data */
-			b = noti->b_text;
-
-			/* Make type to key as char string */
-			snprintf(buf_key, sizeof(buf_key), "%d", type);
+	/* Decode format args read from DB */
+	notification_noti_decode_bundle(noti, NOTIFICATION_BUNDLE_FORMAT_ARGS);
 
-			/* Get value using type key */
-			ret_val = bundle_get_val(b, buf_key);
-			if (ret_val != NULL) {
-				/* If value exist, remove this to add new value */
-				bundle_del(b, buf_key);
-			}
-
-			snprintf(buf_val, sizeof(buf_val), "%s", text);
-
-			/* Add new text value */
-			bundle_add(b, buf_key, buf_val);
-		} else {
-			/* If text bundle does not exist, create new one */
-			b = bundle_create();
-
-			/* Make type to key as char string */
-			snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-			snprintf(buf_val, sizeof(buf_val), "%s", text);
-
-			/* Add new text value */
-			bundle_add(b, buf_key, buf_val);
-
-			/* Save text bundle */
-			noti->b_text = b;
-		}
-	} else {
-		/* Reset if text is NULL */
-		if (noti->b_text != NULL) {
-			/* If text bundle exist, store local bundle data */
-			b = noti->b_text;
-
-			/* Make type to key as char string */
-			snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-			/* Get value using type key */
-			ret_val = bundle_get_val(b, buf_key);
-			if (ret_val != NULL) {
-				/* If value exist, remove this */
-				bundle_del(b, buf_key);
-			}
-		}
+	/* Save text, reset if text is NULL */
+	if (text != NULL) {
+		snprintf(buf_val, sizeof(buf_val), "%s", text);
+	}
+	noti_err = _notification_set_slot(noti, &noti->text[type],
+					  text != NULL ? buf_val : NULL);
+	if (noti_err != NOTIFICATION_ERROR_NONE) {
+		return noti_err;
 	}
 
-	/* Save key if key is valid data */
+	/* Save key, reset if key is NULL */
 	if (key != NULL) {
-		/* Check key bundle exist */
-		if (noti->b_key != NULL) {
-			/* If key bundle exist,  store local bundle data */
-			b = noti->b_key;
-
-			/* Make type to key as char string */
-			snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-			/* Get value using type key */
-			ret_val = bundle_get_val(b, buf_key);
-			if (ret_val != NULL) {
-				/* If value exist, remove this to add new value */
-				bundle_del(b, buf_key);
-			}
-
-			snprintf(buf_val, sizeof(buf_val), "%s", key);
-
-			/* Add new key value */
-			bundle_add(b, buf_key, buf_val);
-		} else {
-			/* If key bundle does not exist, create new one */
-			b = bundle_create();
-
-			/* Make type to key as char string */
-			snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-			snprintf(buf_val, sizeof(buf_val), "%s", key);
-
-			/* Add new key value */
-			bundle_add(b, buf_key, buf_val);
-
-			/* Save key bundle */
-			noti->b_key = b;
-		}
-	} else {
-		/* Reset if key is NULL */
-		if (noti->b_key != NULL) {
-			/* If key bundle exist,  store local bundle data */
-			b = noti->b_key;
-
-			/* Make type to key as char string */
-			snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-			/* Get value using type key */
-			ret_val = bundle_get_val(b, buf_key);
-			if (ret_val != NULL) {
-				/* If value exist, remove this */
-				bundle_del(b, buf_key);
-			}
-		}
+		snprintf(buf_val, sizeof(buf_val), "%s", key);
 	}
-
-	if (noti->b_format_args != NULL) {
-		b = noti->b_format_args;
-	} else {
-		b = bundle_create();
+	noti_err = _notification_set_slot(noti, &noti->key[type],
+					  key != NULL ? buf_val : NULL);
+	if (noti_err != NOTIFICATION_ERROR_NONE) {
+		return noti_err;
 	}
 
 	va_start(var_args, args_type);
@@ -783,81 +1307,41 @@ EXPORT_API notification_error_e notification_set_text(notification_h noti,
 	num_args = 0;
 
 	while (var_type != NOTIFICATION_VARIABLE_TYPE_NONE) {
-		/* Type */
-		snprintf(buf_key, sizeof(buf_key), "%dtype%d", type, num_args);
-		snprintf(buf_val, sizeof(buf_val), "%d", var_type);
-
-		ret_val = bundle_get_val(b, buf_key);
-		if (ret_val != NULL) {
-			bundle_del(b, buf_key);
+		if (num_args == size_args) {
+			size_args = size_args > 0 ? size_args * 2 : 4;
+			new_args = realloc(args, size_args *
+					   sizeof(notification_format_arg_s));
+			if (new_args == NULL) {
+				noti_err = NOTIFICATION_ERROR_NO_MEMORY;
+				break;
+			}
+			args = new_args;
 		}
 
-		bundle_add(b, buf_key, buf_val);
+		args[num_args].type = var_type;
 
 		switch (var_type) {
 		case NOTIFICATION_VARIABLE_TYPE_INT:
-			var_value_int = va_arg(var_args, int);
-
-			/* Value */
-			snprintf(buf_key, sizeof(buf_key), "%dvalue%d", type,
-				 num_args);
-			snprintf(buf_val, sizeof(buf_val), "%d", var_value_int);
-
-			ret_val = bundle_get_val(b, buf_key);
-			if (ret_val != NULL) {
-				bundle_del(b, buf_key);
-			}
-
-			bundle_add(b, buf_key, buf_val);
+			args[num_args].value.i = va_arg(var_args, int);
 			break;
 		case NOTIFICATION_VARIABLE_TYPE_DOUBLE:
-			var_value_double = va_arg(var_args, double);
-
-			/* Value */
-			snprintf(buf_key, sizeof(buf_key), "%dvalue%d", type,
-				 num_args);
-			snprintf(buf_val, sizeof(buf_val), "%.2f",
-				 var_value_double);
-
-			ret_val = bundle_get_val(b, buf_key);
-			if (ret_val != NULL) {
-				bundle_del(b, buf_key);
-			}
-
-			bundle_add(b, buf_key, buf_val);
+			args[num_args].value.d = va_arg(var_args, double);
 			break;
 		case NOTIFICATION_VARIABLE_TYPE_STRING:
 			var_value_string = va_arg(var_args, char *);
 
-			/* Value */
-			snprintf(buf_key, sizeof(buf_key), "%dvalue%d", type,
-				 num_args);
-			snprintf(buf_val, sizeof(buf_val), "%s",
-				 var_value_string);
-
-			ret_val = bundle_get_val(b, buf_key);
-			if (ret_val != NULL) {
-				bundle_del(b, buf_key);
+			args[num_args].value.s = NULL;
+			if (var_value_string != NULL) {
+				args[num_args].value.s =
+				    strdup(var_value_string);
+				if (args[num_args].value.s == NULL) {
+					noti_err = NOTIFICATION_ERROR_NO_MEMORY;
+				}
 			}
-
-			bundle_add(b, buf_key, buf_val);
 			break;
 		case NOTIFICATION_VARIABLE_TYPE_COUNT:
-			var_value_count =
+			args[num_args].value.i =
 			    va_arg(var_args, notification_count_pos_type_e);
-
-			/* Value */
-			snprintf(buf_key, sizeof(buf_key), "%dvalue%d", type,
-				 num_args);
-			snprintf(buf_val, sizeof(buf_val), "%d",
-				 var_value_count);
-
-			ret_val = bundle_get_val(b, buf_key);
-			if (ret_val != NULL) {
-				bundle_del(b, buf_key);
-			}
-
-			bundle_add(b, buf_key, buf_val);
 			break;
 		default:
 			NOTIFICATION_ERR("Error. invalid variable type. : %d",
@@ -866,38 +1350,78 @@ EXPORT_API notification_error_e notification_set_text(notification_h noti,
 			break;
 		}
 
+		if (noti_err != NOTIFICATION_ERROR_NONE) {
+			break;
+		}
+
 		num_args++;
 		var_type = va_arg(var_args, notification_variable_type_e);
 	}
 	va_end(var_args);
 
-	if (noti_err == NOTIFICATION_ERROR_NONE) {
-		noti->num_format_args = num_args;
+	/* Replace format args of type, no format args if error */
+	notification_noti_free_format_args(noti, type);
+
+	if (noti_err == NOTIFICATION_ERROR_NONE && num_args > 0) {
+		noti->format_args[type] = args;
+		noti->num_format_args[type] = num_args;
 	} else {
-		noti->num_format_args = 0;
+		for (i = 0; i < num_args; i++) {
+			if (args[i].type == NOTIFICATION_VARIABLE_TYPE_STRING) {
+				free(args[i].value.s);
+			}
+		}
+		free(args);
+	}
+
+	return noti_err;
+}
+
+/* Format arg for %d, arg of other type is converted */
+static int _notification_format_arg_int(const notification_format_arg_s *arg)
+{
+	if (arg->type == NOTIFICATION_VARIABLE_TYPE_DOUBLE) {
+		return (int)arg->value.d;
+	} else if (arg->type == NOTIFICATION_VARIABLE_TYPE_STRING) {
+		return arg->value.s != NULL ? atoi(arg->value.s) : 0;
 	}
 
-	snprintf(buf_key, sizeof(buf_key), "num%d", type);
-	snprintf(buf_val, sizeof(buf_val), "%d", noti->num_format_args);
+	return arg->value.i;
+}
 
-	ret_val = bundle_get_val(b, buf_key);
-	if (ret_val != NULL) {
-		bundle_del(b, buf_key);
+/* Format arg for %f, arg of other type is converted */
+static double _notification_format_arg_double(const notification_format_arg_s *arg)
+{
+	if (arg->type == NOTIFICATION_VARIABLE_TYPE_DOUBLE) {
+		return arg->value.d;
+	} else if (arg->type == NOTIFICATION_VARIABLE_TYPE_STRING) {
+		return arg->value.s != NULL ? atof(arg->value.s) : 0.0;
 	}
 
-	bundle_add(b, buf_key, buf_val);
+	return arg->value.i;
+}
 
-	noti->b_format_args = b;
+/* Format arg for %s, arg of other type is printed to buf */
+static const char *_notification_format_arg_string(const notification_format_arg_s *arg,
+						   char *buf, int size)
+{
+	if (arg->type == NOTIFICATION_VARIABLE_TYPE_STRING) {
+		return arg->value.s != NULL ? arg->value.s : "";
+	} else if (arg->type == NOTIFICATION_VARIABLE_TYPE_DOUBLE) {
+		snprintf(buf, size, "%.2f", arg->value.d);
+	} else {
+		snprintf(buf, size, "%d", arg->value.i);
+	}
 
-	return noti_err;
+	return buf;
 }
 
 EXPORT_API notification_error_e notification_get_text(notification_h noti,
 						      notification_text_type_e type,
 						      char **text)
 {
-	bundle *b = NULL;
-	char buf_key[32] = { 0, };
+	notification_format_arg_s *args = NULL;
+	int num_format_args = 0;
 	const char *ret_val = NULL;
 	const char *pkgname = NULL;
 	const char *get_str = NULL;
@@ -911,9 +1435,7 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 	char result_str[1024] = { 0, };
 	char buf_str[1024] = { 0, };
 	int num_args = 0;
-	notification_variable_type_e ret_var_type = 0;
 	int ret_variable_int = 0;
-	double ret_variable_double = 0.0;
 
 	/* Check noti is valid data */
 	if (noti == NULL || text == NULL) {
@@ -926,16 +1448,15 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
-	/* Check key */
-	if (noti->b_key != NULL) {
-		b = noti->b_key;
+	/* Decode format args read from DB */
+	notification_noti_decode_bundle(noti, NOTIFICATION_BUNDLE_FORMAT_ARGS);
 
+	/* Check key */
+	if (noti->key[type] != NULL) {
 		/* Get text domain and dir */
 		_notification_get_text_domain(noti);
 
-		snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-		ret_val = bundle_get_val(b, buf_key);
+		ret_val = noti->key[type];
 		if (ret_val != NULL && noti->domain != NULL
 		    && noti->dir != NULL) {
 			/* Get application string */
@@ -950,12 +1471,9 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 		}
 	}
 
-	if (get_str == NULL && noti->b_text != NULL) {
-		b = noti->b_text;
+	if (get_str == NULL) {
 		/* Get basic text */
-		snprintf(buf_key, sizeof(buf_key), "%d", type);
-
-		get_str = bundle_get_val(b, buf_key);
+		get_str = noti->text[type];
 	}
 
 	check_type = type;
@@ -975,16 +1493,11 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 			}
 
 			/* Check key */
-			if (noti->b_key != NULL) {
-				b = noti->b_key;
-
+			if (noti->key[check_type] != NULL) {
 				/* Get text domain and dir */
 				_notification_get_text_domain(noti);
 
-				snprintf(buf_key, sizeof(buf_key), "%d",
-					 check_type);
-
-				ret_val = bundle_get_val(b, buf_key);
+				ret_val = noti->key[check_type];
 				if (ret_val != NULL && noti->domain != NULL
 				    && noti->dir != NULL) {
 					/* Get application string */
@@ -1001,13 +1514,9 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 				}
 			}
 
-			if (get_check_type_str == NULL && noti->b_text != NULL) {
-				b = noti->b_text;
+			if (get_check_type_str == NULL) {
 				/* Get basic text */
-				snprintf(buf_key, sizeof(buf_key), "%d",
-					 check_type);
-
-				get_check_type_str = bundle_get_val(b, buf_key);
+				get_check_type_str = noti->text[check_type];
 			}
 		}
 
@@ -1022,49 +1531,28 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 	}
 
 	if (get_str != NULL) {
-		/* Get number format args */
-		b = noti->b_format_args;
-		noti->num_format_args = 0;
-
-		if (b != NULL) {
-			snprintf(buf_key, sizeof(buf_key), "num%d", check_type);
-			ret_val = bundle_get_val(b, buf_key);
-			if (ret_val != NULL) {
-				noti->num_format_args = atoi(ret_val);
-			}
-		}
+		/* Get format args */
+		args = noti->format_args[check_type];
+		num_format_args = noti->num_format_args[check_type];
 
-		if (noti->num_format_args == 0) {
+		if (num_format_args == 0) {
 			*text = (char *)get_str;
 		} else {
 			/* Check first variable is count, LEFT pos */
-			snprintf(buf_key, sizeof(buf_key), "%dtype%d",
-				 check_type, num_args);
-			ret_val = bundle_get_val(b, buf_key);
-			ret_var_type = atoi(ret_val);
-
-			if (ret_var_type == NOTIFICATION_VARIABLE_TYPE_COUNT) {
-				/* Get var Value */
-				snprintf(buf_key, sizeof(buf_key), "%dvalue%d",
-					 check_type, num_args);
-				ret_val = bundle_get_val(b, buf_key);
-				ret_variable_int = atoi(ret_val);
-
-				if (ret_variable_int ==
-				    NOTIFICATION_COUNT_POS_LEFT) {
-					notification_noti_get_count(noti->type,
-								    noti->caller_pkgname,
-								    noti->group_id,
-								    noti->priv_id,
-								    &ret_variable_int);
-					snprintf(buf_str, sizeof(buf_str),
-						 "%d ", ret_variable_int);
-					strncat(result_str, buf_str,
-						sizeof(result_str));
-
-					num_args++;
-				}
-
+			if (args[num_args].type == NOTIFICATION_VARIABLE_TYPE_COUNT
+			    && args[num_args].value.i ==
+			    NOTIFICATION_COUNT_POS_LEFT) {
+				notification_noti_get_count(noti->type,
+							    noti->caller_pkgname,
+							    noti->group_id,
+							    noti->priv_id,
+							    &ret_variable_int);
+				snprintf(buf_str, sizeof(buf_str), "%d ",
+					 ret_variable_int);
+				strncat(result_str, buf_str,
+					sizeof(result_str));
+
+				num_args++;
 			}
 
 			/* Check variable IN pos */
@@ -1077,17 +1565,10 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 						strncat(result_str, temp_str,
 							1);
 					} else if (*(temp_str + 1) == 'd') {
-						/* Get var Type */
 						ret_variable_int = 0;
 
-						snprintf(buf_key,
-							 sizeof(buf_key),
-							 "%dtype%d", check_type,
-							 num_args);
-						ret_val =
-						    bundle_get_val(b, buf_key);
-						ret_var_type = atoi(ret_val);
-						if (ret_var_type ==
+						if (num_args < num_format_args
+						    && args[num_args].type ==
 						    NOTIFICATION_VARIABLE_TYPE_COUNT)
 						{
 							/* Get notification count */
@@ -1097,19 +1578,10 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 							     noti->group_id,
 							     noti->priv_id,
 							     &ret_variable_int);
-						} else {
-							/* Get var Value */
-							snprintf(buf_key,
-								 sizeof
-								 (buf_key),
-								 "%dvalue%d",
-								 check_type,
-								 num_args);
-							ret_val =
-							    bundle_get_val(b,
-									   buf_key);
+						} else if (num_args < num_format_args) {
 							ret_variable_int =
-							    atoi(ret_val);
+							    _notification_format_arg_int
+							    (&args[num_args]);
 						}
 
 						snprintf(buf_str,
@@ -1122,40 +1594,29 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 
 						num_args++;
 					} else if (*(temp_str + 1) == 's') {
-						/* Get var Value */
-						snprintf(buf_key,
-							 sizeof(buf_key),
-							 "%dvalue%d",
-							 check_type, num_args);
-						ret_val =
-						    bundle_get_val(b, buf_key);
-
-						snprintf(buf_str,
-							 sizeof(buf_str), "%s",
-							 ret_val);
-						strncat(result_str, buf_str,
-							sizeof(result_str));
+						if (num_args < num_format_args) {
+							strncat(result_str,
+								_notification_format_arg_string
+								(&args[num_args],
+								 buf_str,
+								 sizeof(buf_str)),
+								sizeof(result_str));
+						}
 
 						temp_str++;
 
 						num_args++;
 					} else if (*(temp_str + 1) == 'f') {
-						/* Get var Value */
-						snprintf(buf_key,
-							 sizeof(buf_key),
-							 "%dvalue%d",
-							 check_type, num_args);
-						ret_val =
-						    bundle_get_val(b, buf_key);
-						ret_variable_double =
-						    atof(ret_val);
-
-						snprintf(buf_str,
-							 sizeof(buf_str),
-							 "%.2f",
-							 ret_variable_double);
-						strncat(result_str, buf_str,
-							sizeof(result_str));
+						if (num_args < num_format_args) {
+							snprintf(buf_str,
+								 sizeof(buf_str),
+								 "%.2f",
+								 _notification_format_arg_double
+								 (&args[num_args]));
+							strncat(result_str,
+								buf_str,
+								sizeof(result_str));
+						}
 
 						temp_str++;
 
@@ -1165,39 +1626,23 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 
 			}
 
-			/* Check last variable is count, LEFT pos */
-			if (num_args < noti->num_format_args) {
-				snprintf(buf_key, sizeof(buf_key), "%dtype%d",
-					 check_type, num_args);
-				ret_val = bundle_get_val(b, buf_key);
-				ret_var_type = atoi(ret_val);
-				if (ret_var_type ==
-				    NOTIFICATION_VARIABLE_TYPE_COUNT) {
-					/* Get var Value */
-					snprintf(buf_key, sizeof(buf_key),
-						 "%dvalue%d", check_type,
-						 num_args);
-					ret_val = bundle_get_val(b, buf_key);
-					ret_variable_int = atoi(ret_val);
-
-					if (ret_variable_int ==
-					    NOTIFICATION_COUNT_POS_RIGHT) {
-						notification_noti_get_count
-						    (noti->type,
-						     noti->caller_pkgname,
-						     noti->group_id,
-						     noti->priv_id,
-						     &ret_variable_int);
-						snprintf(buf_str,
-							 sizeof(buf_str), " %d",
-							 ret_variable_int);
-						strncat(result_str, buf_str,
-							sizeof(result_str));
-
-						num_args++;
-					}
-
-				}
+			/* Check last variable is count, RIGHT pos */
+			if (num_args < num_format_args
+			    && args[num_args].type ==
+			    NOTIFICATION_VARIABLE_TYPE_COUNT
+			    && args[num_args].value.i ==
+			    NOTIFICATION_COUNT_POS_RIGHT) {
+				notification_noti_get_count(noti->type,
+							    noti->caller_pkgname,
+							    noti->group_id,
+							    noti->priv_id,
+							    &ret_variable_int);
+				snprintf(buf_str, sizeof(buf_str), " %d",
+					 ret_variable_int);
+				strncat(result_str, buf_str,
+					sizeof(result_str));
+
+				num_args++;
 			}
 
 			switch (check_type) {
@@ -1253,6 +1698,10 @@ EXPORT_API notification_error_e notification_get_text(notification_h noti,
 			}
 
 			/* Third, get app name from service data */
+			if (noti->app_name == NULL) {
+				notification_noti_decode_bundle(noti,
+								NOTIFICATION_BUNDLE_SERVICE_SINGLE_LAUNCH);
+			}
 			if (noti->app_name == NULL
 			    && noti->b_service_single_launch != NULL) {
 				pkgname =
@@ -1288,7 +1737,7 @@ EXPORT_API notification_error_e notification_set_text_domain(notification_h noti
 	/* Check domain */
 	if (noti->domain) {
 		/* Remove previous domain */
-		free(noti->domain);
+		notification_arena_free(noti->arena, noti->domain);
 	}
 	/* Copy domain */
 	noti->domain = strdup(domain);
@@ -1296,7 +1745,7 @@ EXPORT_API notification_error_e notification_set_text_domain(notification_h noti
 	/* Check locale dir */
 	if (noti->dir) {
 		/* Remove previous locale dir */
-		free(noti->dir);
+		notification_arena_free(noti->arena, noti->dir);
 	}
 	/* Copy locale dir */
 	noti->dir = strdup(dir);
@@ -1347,13 +1796,13 @@ EXPORT_API notification_error_e notification_set_sound(notification_h noti,
 	/* Save sound path if user data type */
 	if (type == NOTIFICATION_SOUND_TYPE_USER_DATA && path != NULL) {
 		if (noti->sound_path != NULL) {
-			free(noti->sound_path);
+			notification_arena_free(noti->arena, noti->sound_path);
 		}
 
 		noti->sound_path = strdup(path);
 	} else {
 		if (noti->sound_path != NULL) {
-			free(noti->sound_path);
+			notification_arena_free(noti->arena, noti->sound_path);
 			noti->sound_path = NULL;
 		}
 	}
@@ -1403,13 +1852,13 @@ EXPORT_API notification_error_e notification_set_vibration(notification_h noti,
 	/* Save sound path if user data type */
 	if (type == NOTIFICATION_VIBRATION_TYPE_USER_DATA && path != NULL) {
 		if (noti->vibration_path != NULL) {
-			free(noti->vibration_path);
+			notification_arena_free(noti->arena, noti->vibration_path);
 		}
 
 		noti->vibration_path = strdup(path);
 	} else {
 		if (noti->vibration_path != NULL) {
-			free(noti->vibration_path);
+			notification_arena_free(noti->arena, noti->vibration_path);
 			noti->vibration_path = NULL;
 		}
 	}
@@ -1447,7 +1896,7 @@ EXPORT_API notification_error_e notification_set_application(notification_h noti
 	}
 
 	if (noti->launch_pkgname) {
-		free(noti->launch_pkgname);
+		notification_arena_free(noti->arena, noti->launch_pkgname);
 	}
 
 	noti->launch_pkgname = strdup(pkgname);
@@ -1479,6 +1928,10 @@ EXPORT_API notification_error_e notification_set_args(notification_h noti,
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
+	/* Drop encoded args read from DB */
+	notification_noti_decode_bundle(noti, NOTIFICATION_BUNDLE_ARGS);
+	notification_noti_decode_bundle(noti, NOTIFICATION_BUNDLE_GROUP_ARGS);
+
 	if (noti->args) {
 		bundle_free(noti->args);
 	}
@@ -1505,6 +1958,10 @@ EXPORT_API notification_error_e notification_get_args(notification_h noti,
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
+	/* Decode args read from DB */
+	notification_noti_decode_bundle(noti, NOTIFICATION_BUNDLE_ARGS);
+	notification_noti_decode_bundle(noti, NOTIFICATION_BUNDLE_GROUP_ARGS);
+
 	if (noti->args) {
 		*args = noti->args;
 	} else {
@@ -1537,6 +1994,9 @@ EXPORT_API notification_error_e notification_set_execute_option(notification_h n
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
+	/* Decode execute option and services read from DB */
+	_notification_decode_execute_option(noti);
+
 	/* Create execute option bundle if does not exist */
 	if (noti->b_execute_option != NULL) {
 		noti->b_execute_option = bundle_create();
@@ -1641,6 +2101,9 @@ EXPORT_API notification_error_e notification_get_execute_option(notification_h n
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
+	/* Decode execute option and services read from DB */
+	_notification_decode_execute_option(noti);
+
 	switch (type) {
 	case NOTIFICATION_EXECUTE_TYPE_RESPONDING:
 		b = noti->b_service_responding;
@@ -1831,19 +2294,24 @@ EXPORT_API notification_error_e notification_get_progress(notification_h noti,
 EXPORT_API notification_error_e notification_set_pkgname(notification_h noti,
 							 const char *pkgname)
 {
+	char *old_pkgname = NULL;
+
 	/* check noti and pkgname are valid data */
 	if (noti == NULL || pkgname == NULL) {
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
+	old_pkgname = noti->caller_pkgname;
+	noti->caller_pkgname = strdup(pkgname);
+
+	/* Lists finding it by priv_id have it under new pkgname */
+	notification_list_rehash(noti, old_pkgname, noti->priv_id);
+
 	/* Remove previous caller pkgname */
-	if (noti->caller_pkgname) {
-		free(noti->caller_pkgname);
-		noti->caller_pkgname = NULL;
+	if (old_pkgname) {
+		notification_arena_free(noti->arena, old_pkgname);
 	}
 
-	noti->caller_pkgname = strdup(pkgname);
-
 	return NOTIFICATION_ERROR_NONE;
 }
 
@@ -1896,6 +2364,32 @@ EXPORT_API notification_error_e notification_set_badge(const char *pkgname,
 	return ret;
 }
 
+EXPORT_API notification_error_e notification_add_badge(const char *pkgname,
+						       int group_id, int delta)
+{
+	char *caller_pkgname = NULL;
+	int ret = NOTIFICATION_ERROR_NONE;
+
+	/* Check pkgname */
+	if (pkgname == NULL) {
+		caller_pkgname = _notification_get_pkgname_by_pid();
+
+		/* Add delta to count of Group DB */
+		ret =
+		    notification_group_add_badge(caller_pkgname, group_id,
+						 delta);
+
+		if (caller_pkgname != NULL) {
+			free(caller_pkgname);
+		}
+	} else {
+		/* Add delta to count of Group DB */
+		ret = notification_group_add_badge(pkgname, group_id, delta);
+	}
+
+	return ret;
+}
+
 EXPORT_API notification_error_e notification_get_badge(const char *pkgname,
 						       int group_id, int *count)
 {
@@ -2006,7 +2500,10 @@ EXPORT_API notification_error_e notification_insert(notification_h noti,
 		/* Disable changed cb */
 	} else {
 		/* Enable changed cb */
-		_notification_changed(NOTI_CHANGED_NOTI);
+		_notification_changed(NOTIFICATION_OP_INSERT,
+				      noti->caller_pkgname, noti->type,
+				      &noti->priv_id, 1,
+				      noti->display_applist);
 	}
 
 	/* If priv_id is valid data, set priv_id */
@@ -2017,6 +2514,89 @@ EXPORT_API notification_error_e notification_insert(notification_h noti,
 	return NOTIFICATION_ERROR_NONE;
 }
 
+EXPORT_API notification_error_e notification_insert_batch(notification_h * notis,
+							  int n, int *priv_ids)
+{
+	int *changed_ids = NULL;
+	int num_changed = 0;
+	int changed_applist = 0;
+	int ret = 0;
+	int i = 0;
+
+	/* Check notis are vaild data */
+	if (notis == NULL || n <= 0) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	for (i = 0; i < n; i++) {
+		if (notis[i] == NULL) {
+			return NOTIFICATION_ERROR_INVALID_DATA;
+		}
+
+		/* Check noti type is valid type */
+		if (notis[i]->type <= NOTIFICATION_TYPE_NONE
+		    || notis[i]->type >= NOTIFICATION_TYPE_MAX) {
+			return NOTIFICATION_ERROR_INVALID_DATA;
+		}
+	}
+
+	/* Save insert time */
+	for (i = 0; i < n; i++) {
+		notis[i]->insert_time = time(NULL);
+	}
+
+	/* Insert into DB */
+	ret = notification_noti_insert_batch(notis, n);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
+	}
+
+	/* If priv_ids is valid data, set priv_id */
+	if (priv_ids != NULL) {
+		for (i = 0; i < n; i++) {
+			priv_ids[i] = notis[i]->priv_id;
+		}
+	}
+
+	/* One changed notification for each run of same pkgname and type */
+	changed_ids = malloc(sizeof(int) * n);
+	for (i = 0; i < n; i++) {
+		/* Check disable update on insert property */
+		if (changed_ids != NULL
+		    && !(notis[i]->flags_for_property
+			 & NOTIFICATION_PROP_DISABLE_UPDATE_ON_INSERT)) {
+			changed_ids[num_changed++] = notis[i]->priv_id;
+			changed_applist |= notis[i]->display_applist;
+		}
+
+		if (num_changed > 0
+		    && (i + 1 == n
+			|| notis[i + 1]->type != notis[i]->type
+			|| notis[i + 1]->caller_pkgname == NULL
+			|| notis[i]->caller_pkgname == NULL
+			|| strcmp(notis[i + 1]->caller_pkgname,
+				  notis[i]->caller_pkgname))) {
+			_notification_changed(NOTIFICATION_OP_INSERT,
+					      notis[i]->caller_pkgname,
+					      notis[i]->type, changed_ids,
+					      num_changed, changed_applist);
+			num_changed = 0;
+			changed_applist = 0;
+		}
+	}
+
+	if (changed_ids == NULL) {
+		/* No memory for ids, let subscribers reload */
+		_notification_changed(NOTIFICATION_OP_NONE, NULL,
+				      NOTIFICATION_TYPE_NONE, NULL, 0,
+				      NOTIFICATION_DISPLAY_APP_ALL);
+	} else {
+		free(changed_ids);
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
 EXPORT_API notification_error_e notification_update(notification_h noti)
 {
 	int ret = 0;
@@ -2030,10 +2610,18 @@ EXPORT_API notification_error_e notification_update(notification_h noti)
 		if (ret != NOTIFICATION_ERROR_NONE) {
 			return ret;
 		}
-	}
 
-	/* Send changed notification */
-	_notification_changed(NOTI_CHANGED_NOTI);
+		/* Send changed notification */
+		_notification_changed(NOTIFICATION_OP_UPDATE,
+				      noti->caller_pkgname, noti->type,
+				      &noti->priv_id, 1,
+				      noti->display_applist);
+	} else {
+		/* Send changed notification, subscribers reload */
+		_notification_changed(NOTIFICATION_OP_NONE, NULL,
+				      NOTIFICATION_TYPE_NONE, NULL, 0,
+				      NOTIFICATION_DISPLAY_APP_ALL);
+	}
 
 	return NOTIFICATION_ERROR_NONE;
 }
@@ -2041,15 +2629,19 @@ EXPORT_API notification_error_e notification_update(notification_h noti)
 EXPORT_API notification_error_e notifiation_clear(notification_type_e type)
 {
 	int ret = 0;
+	int num_deleted = 0;
 
 	/* Delete all notification of type */
-	ret = notification_noti_delete_all(type, NULL);
+	ret = notification_noti_delete_all(type, NULL, &num_deleted);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		return ret;
 	}
 
 	/* Send chagned notification */
-	_notification_changed(NOTI_CHANGED_NOTI);
+	if (num_deleted > 0) {
+		_notification_changed(NOTIFICATION_OP_DELETE_ALL, NULL, type,
+				      NULL, 0, NOTIFICATION_DISPLAY_APP_ALL);
+	}
 
 	return NOTIFICATION_ERROR_NONE;
 }
@@ -2058,6 +2650,7 @@ EXPORT_API notification_error_e notification_delete_all_by_type(const char *pkgn
 								notification_type_e type)
 {
 	int ret = 0;
+	int num_deleted = 0;
 	char *caller_pkgname = NULL;
 
 	if (pkgname == NULL) {
@@ -2066,13 +2659,17 @@ EXPORT_API notification_error_e notification_delete_all_by_type(const char *pkgn
 		caller_pkgname = strdup(pkgname);
 	}
 
-	ret = notification_noti_delete_all(type, caller_pkgname);
+	ret = notification_noti_delete_all(type, caller_pkgname, &num_deleted);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		free(caller_pkgname);
 		return ret;
 	}
 
-	_notification_changed(NOTI_CHANGED_NOTI);
+	if (num_deleted > 0) {
+		_notification_changed(NOTIFICATION_OP_DELETE_ALL,
+				      caller_pkgname, type, NULL, 0,
+				      NOTIFICATION_DISPLAY_APP_ALL);
+	}
 
 	free(caller_pkgname);
 
@@ -2084,9 +2681,54 @@ EXPORT_API notification_error_e notification_delete_group_by_group_id(const char
 								      int group_id)
 {
 	int ret = 0;
+	int num_deleted = 0;
+	int *list_deleted = NULL;
+	char *caller_pkgname = NULL;
+
+	if (group_id < NOTIFICATION_GROUP_ID_NONE) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	if (pkgname == NULL) {
+		caller_pkgname = _notification_get_pkgname_by_pid();
+	} else {
+		caller_pkgname = strdup(pkgname);
+	}
+
+	ret =
+	    notification_noti_delete_group_by_group_id(caller_pkgname,
+						       group_id, &num_deleted,
+						       &list_deleted);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		free(caller_pkgname);
+		return ret;
+	}
+
+	if (num_deleted > 0) {
+		_notification_changed(NOTIFICATION_OP_DELETE, caller_pkgname,
+				      type, list_deleted, num_deleted,
+				      NOTIFICATION_DISPLAY_APP_ALL);
+	}
+
+	if (list_deleted) {
+		free(list_deleted);
+	}
+
+	free(caller_pkgname);
+
+	return ret;
+}
+
+EXPORT_API notification_error_e notification_delete_group_by_priv_id(const char *pkgname,
+								     notification_type_e type,
+								     int priv_id)
+{
+	int ret = 0;
+	int num_deleted = 0;
+	int *list_deleted = NULL;
 	char *caller_pkgname = NULL;
 
-	if (group_id < NOTIFICATION_GROUP_ID_NONE) {
+	if (priv_id < NOTIFICATION_PRIV_ID_NONE) {
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
@@ -2097,28 +2739,38 @@ EXPORT_API notification_error_e notification_delete_group_by_group_id(const char
 	}
 
 	ret =
-	    notification_noti_delete_group_by_group_id(caller_pkgname,
-						       group_id);
+	    notification_noti_delete_group_by_priv_id(caller_pkgname, priv_id,
+						      &num_deleted,
+						      &list_deleted);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		free(caller_pkgname);
 		return ret;
 	}
 
-	_notification_changed(NOTI_CHANGED_NOTI);
+	if (num_deleted > 0) {
+		_notification_changed(NOTIFICATION_OP_DELETE, caller_pkgname,
+				      type, list_deleted, num_deleted,
+				      NOTIFICATION_DISPLAY_APP_ALL);
+	}
+
+	if (list_deleted) {
+		free(list_deleted);
+	}
 
 	free(caller_pkgname);
 
 	return ret;
 }
 
-EXPORT_API notification_error_e notification_delete_group_by_priv_id(const char *pkgname,
-								     notification_type_e type,
-								     int priv_id)
+EXPORT_API notification_error_e notification_delete_by_priv_id(const char *pkgname,
+							       notification_type_e type,
+							       int priv_id)
 {
 	int ret = 0;
+	int num_deleted = 0;
 	char *caller_pkgname = NULL;
 
-	if (priv_id < NOTIFICATION_PRIV_ID_NONE) {
+	if (priv_id <= NOTIFICATION_PRIV_ID_NONE) {
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
@@ -2128,45 +2780,60 @@ EXPORT_API notification_error_e notification_delete_group_by_priv_id(const char
 		caller_pkgname = strdup(pkgname);
 	}
 
-	ret =
-	    notification_noti_delete_group_by_priv_id(caller_pkgname, priv_id);
+	ret = notification_noti_delete_by_priv_id(caller_pkgname, priv_id,
+						  &num_deleted);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		free(caller_pkgname);
 		return ret;
 	}
 
-	_notification_changed(NOTI_CHANGED_NOTI);
+	_notification_changed(NOTIFICATION_OP_DELETE, caller_pkgname, type,
+			      &priv_id, num_deleted,
+			      NOTIFICATION_DISPLAY_APP_ALL);
 
 	free(caller_pkgname);
 
 	return ret;
 }
 
-EXPORT_API notification_error_e notification_delete_by_priv_id(const char *pkgname,
-							       notification_type_e type,
-							       int priv_id)
+EXPORT_API int notification_delete_batch(const char *pkgname,
+					const int *priv_ids, int n)
 {
 	int ret = 0;
 	char *caller_pkgname = NULL;
+	int *deleted_ids = NULL;
 
-	if (priv_id <= NOTIFICATION_PRIV_ID_NONE) {
+	if (priv_ids == NULL || n <= 0) {
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
+	deleted_ids = malloc(sizeof(int) * n);
+	if (deleted_ids == NULL) {
+		return NOTIFICATION_ERROR_NO_MEMORY;
+	}
+
 	if (pkgname == NULL) {
 		caller_pkgname = _notification_get_pkgname_by_pid();
 	} else {
 		caller_pkgname = strdup(pkgname);
 	}
 
-	ret = notification_noti_delete_by_priv_id(caller_pkgname, priv_id);
-	if (ret != NOTIFICATION_ERROR_NONE) {
+	ret = notification_noti_delete_batch(caller_pkgname, priv_ids, n,
+					     deleted_ids);
+	if (ret < 0) {
+		free(deleted_ids);
 		free(caller_pkgname);
 		return ret;
 	}
 
-	_notification_changed(NOTI_CHANGED_NOTI);
+	/* Send chagned notification of deleted rows only */
+	if (ret > 0) {
+		_notification_changed(NOTIFICATION_OP_DELETE, caller_pkgname,
+				      NOTIFICATION_TYPE_NONE, deleted_ids, ret,
+				      NOTIFICATION_DISPLAY_APP_ALL);
+	}
 
+	free(deleted_ids);
 	free(caller_pkgname);
 
 	return ret;
@@ -2175,6 +2842,7 @@ EXPORT_API notification_error_e notification_delete_by_priv_id(const char *pkgna
 EXPORT_API notification_error_e notification_delete(notification_h noti)
 {
 	int ret = 0;
+	int num_deleted = 0;
 
 	if (noti == NULL) {
 		return NOTIFICATION_ERROR_INVALID_DATA;
@@ -2182,7 +2850,7 @@ EXPORT_API notification_error_e notification_delete(notification_h noti)
 
 	ret =
 	    notification_noti_delete_by_priv_id(noti->caller_pkgname,
-						noti->priv_id);
+						noti->priv_id, &num_deleted);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		return ret;
 	}
@@ -2191,7 +2859,10 @@ EXPORT_API notification_error_e notification_delete(notification_h noti)
 		& NOTIFICATION_PROP_DISABLE_UPDATE_ON_DELETE) {
 		NOTIFICATION_INFO("Disabled update while delete.");
 	} else {
-		_notification_changed(NOTI_CHANGED_NOTI);
+		_notification_changed(NOTIFICATION_OP_DELETE,
+				      noti->caller_pkgname, noti->type,
+				      &noti->priv_id, num_deleted,
+				      noti->display_applist);
 	}
 
 	return NOTIFICATION_ERROR_NONE;
@@ -2364,12 +3035,6 @@ EXPORT_API notification_h notification_new(notification_type_e type,
 	noti->domain = NULL;
 	noti->dir = NULL;
 
-	noti->b_text = NULL;
-	noti->b_key = NULL;
-	noti->b_format_args = NULL;
-	noti->num_format_args = 0;
-
-	noti->b_image_path = NULL;
 
 	noti->time = 0;
 	noti->insert_time = 0;
@@ -2391,6 +3056,8 @@ EXPORT_API notification_h notification_new(notification_type_e type,
 EXPORT_API notification_error_e notification_clone(notification_h noti, notification_h *clone)
 {
 	notification_h new_noti = NULL;
+	int i = 0;
+	int j = 0;
 
 	if (noti == NULL || clone == NULL) {
 		NOTIFICATION_ERR("INVALID PARAMETER.");
@@ -2409,6 +3076,7 @@ EXPORT_API notification_error_e notification_clone(notification_h noti, notifica
 	new_noti->group_id = noti->group_id;
 	new_noti->internal_group_id = noti->internal_group_id;
 	new_noti->priv_id = noti->priv_id;
+	new_noti->rowid = noti->rowid;
 
 	if(noti->caller_pkgname != NULL) {
 		new_noti->caller_pkgname = strdup(noti->caller_pkgname);
@@ -2477,28 +3145,60 @@ EXPORT_API notification_error_e notification_clone(notification_h noti, notifica
 		new_noti->dir = NULL;
 	}
 
-	if(noti->b_text != NULL) {
-		new_noti->b_text = bundle_dup(noti->b_text);
-	} else {
-		new_noti->b_text = NULL;
+	for (i = 0; i < NOTIFICATION_TEXT_TYPE_MAX; i++) {
+		if (noti->text[i] != NULL) {
+			new_noti->text[i] = strdup(noti->text[i]);
+		}
+		if (noti->key[i] != NULL) {
+			new_noti->key[i] = strdup(noti->key[i]);
+		}
 	}
-	if(noti->b_key != NULL) {
-		new_noti->b_key = bundle_dup(noti->b_key);
-	} else {
-		new_noti->b_key = NULL;
+	for (i = 0; i < NOTIFICATION_TEXT_TYPE_MAX; i++) {
+		if (noti->num_format_args[i] <= 0) {
+			continue;
+		}
+
+		new_noti->format_args[i] =
+		    malloc(noti->num_format_args[i] *
+			   sizeof(notification_format_arg_s));
+		if (new_noti->format_args[i] == NULL) {
+			continue;
+		}
+
+		memcpy(new_noti->format_args[i], noti->format_args[i],
+		       noti->num_format_args[i] *
+		       sizeof(notification_format_arg_s));
+		new_noti->num_format_args[i] = noti->num_format_args[i];
+
+		for (j = 0; j < new_noti->num_format_args[i]; j++) {
+			if (new_noti->format_args[i][j].type ==
+			    NOTIFICATION_VARIABLE_TYPE_STRING
+			    && noti->format_args[i][j].value.s != NULL) {
+				new_noti->format_args[i][j].value.s =
+				    strdup(noti->format_args[i][j].value.s);
+			}
+		}
 	}
-	if(noti->b_format_args != NULL) {
-		new_noti->b_format_args = bundle_dup(noti->b_format_args);
-	} else {
-		new_noti->b_format_args = NULL;
+
+	for (i = 0; i < NOTIFICATION_IMAGE_TYPE_MAX; i++) {
+		if (noti->image_path[i] != NULL) {
+			new_noti->image_path[i] = strdup(noti->image_path[i]);
+		}
 	}
-	new_noti->num_format_args = noti->num_format_args;
 
-	if(noti->b_image_path != NULL) {
-		new_noti->b_image_path = bundle_dup(noti->b_image_path);
-	} else {
-		new_noti->b_image_path = NULL;
+	/* Bundles not decoded yet are copied encoded */
+	for (i = 0; i < NOTIFICATION_BUNDLE_MAX; i++) {
+		if (noti->raw_bundle[i] != NULL) {
+			new_noti->raw_bundle[i] = malloc(noti->raw_bundle_len[i]);
+			if (new_noti->raw_bundle[i] != NULL) {
+				memcpy(new_noti->raw_bundle[i], noti->raw_bundle[i],
+				       noti->raw_bundle_len[i]);
+				new_noti->raw_bundle_len[i] =
+				    noti->raw_bundle_len[i];
+			}
+		}
 	}
+	new_noti->summary = noti->summary;
 
 	new_noti->time = noti->time;
 	new_noti->insert_time = noti->insert_time;
@@ -2522,15 +3222,19 @@ EXPORT_API notification_error_e notification_clone(notification_h noti, notifica
 
 EXPORT_API notification_error_e notification_free(notification_h noti)
 {
+	notification_arena_s *arena = NULL;
+	int detached = 0;
+	int i = 0;
+
 	if (noti == NULL) {
 		return NOTIFICATION_ERROR_INVALID_DATA;
 	}
 
 	if (noti->caller_pkgname) {
-		free(noti->caller_pkgname);
+		notification_arena_free(noti->arena, noti->caller_pkgname);
 	}
 	if (noti->launch_pkgname) {
-		free(noti->launch_pkgname);
+		notification_arena_free(noti->arena, noti->launch_pkgname);
 	}
 	if (noti->args) {
 		bundle_free(noti->args);
@@ -2553,31 +3257,36 @@ EXPORT_API notification_error_e notification_free(notification_h noti)
 	}
 
 	if (noti->sound_path) {
-		free(noti->sound_path);
+		notification_arena_free(noti->arena, noti->sound_path);
 	}
 	if (noti->vibration_path) {
-		free(noti->vibration_path);
+		notification_arena_free(noti->arena, noti->vibration_path);
 	}
 
 	if (noti->domain) {
-		free(noti->domain);
+		notification_arena_free(noti->arena, noti->domain);
 	}
 	if (noti->dir) {
-		free(noti->dir);
+		notification_arena_free(noti->arena, noti->dir);
 	}
 
-	if (noti->b_text) {
-		bundle_free(noti->b_text);
+	for (i = 0; i < NOTIFICATION_TEXT_TYPE_MAX; i++) {
+		notification_arena_free(noti->arena, noti->text[i]);
+		notification_arena_free(noti->arena, noti->key[i]);
 	}
-	if (noti->b_key) {
-		bundle_free(noti->b_key);
+	for (i = 0; i < NOTIFICATION_TEXT_TYPE_MAX; i++) {
+		notification_noti_free_format_args(noti, i);
 	}
-	if (noti->b_format_args) {
-		bundle_free(noti->b_format_args);
+
+	for (i = 0; i < NOTIFICATION_IMAGE_TYPE_MAX; i++) {
+		notification_arena_free(noti->arena, noti->image_path[i]);
 	}
 
-	if (noti->b_image_path) {
-		bundle_free(noti->b_image_path);
+	for (i = 0; i < NOTIFICATION_BUNDLE_MAX; i++) {
+		if (noti->raw_bundle[i]) {
+			notification_arena_free(noti->arena,
+						noti->raw_bundle[i]);
+		}
 	}
 
 	if (noti->app_icon_path) {
@@ -2593,15 +3302,57 @@ EXPORT_API notification_error_e notification_free(notification_h noti)
 		free(noti->temp_content);
 	}
 
+	if (noti->arena != NULL) {
+		/* Struct is in arena, released with list or by last detached
+		 * notification. Cleared so that freeing it again is harmless,
+		 * and marked so that removing it from list does not detach. */
+		arena = noti->arena;
+		detached = noti->detached;
+
+		memset(noti, 0x00, sizeof(struct _notification));
+		noti->arena = arena;
+		noti->released = 1;
+
+		if (detached) {
+			notification_arena_unref(arena);
+		}
+
+		return NOTIFICATION_ERROR_NONE;
+	}
+
 	free(noti);
 
 	return NOTIFICATION_ERROR_NONE;
 }
 
-EXPORT_API notification_error_e
-notification_resister_changed_cb(void (*changed_cb)
-				 (void *data, notification_type_e type),
-				 void *user_data)
+EXPORT_API notification_error_e notification_detach(notification_h noti)
+{
+	if (noti == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	/* Not in arena, detached already, or freed */
+	if (noti->arena == NULL || noti->detached || noti->released) {
+		return NOTIFICATION_ERROR_NONE;
+	}
+
+	notification_arena_ref(noti->arena);
+	noti->detached = 1;
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+/* Either changed_cb or detailed_changed_cb is set in a list item.
+ * Filter is set for detailed_changed_cb only. */
+static notification_error_e
+_notification_resister_cb(void (*changed_cb)
+			  (void *data, notification_type_e type),
+			  void (*detailed_changed_cb)
+			  (void *data, notification_op_type_e op,
+			   const char *pkgname, notification_type_e type,
+			   const int *priv_ids, int num_priv_ids),
+			  void *user_data, int filtered, const char *pkgname,
+			  notification_type_e type, int applist)
 {
 	notification_cb_list_s *noti_cb_list_new = NULL;
 	notification_cb_list_s *noti_cb_list = NULL;
@@ -2614,13 +3365,25 @@ notification_resister_changed_cb(void (*changed_cb)
 
 	noti_cb_list_new =
 	    (notification_cb_list_s *) malloc(sizeof(notification_cb_list_s));
+	if (noti_cb_list_new == NULL) {
+		_noti_chanaged_monitor_fini();
+		return NOTIFICATION_ERROR_NO_MEMORY;
+	}
 
 	noti_cb_list_new->next = NULL;
 	noti_cb_list_new->prev = NULL;
 
 	noti_cb_list_new->changed_cb = changed_cb;
+	noti_cb_list_new->detailed_changed_cb = detailed_changed_cb;
 	noti_cb_list_new->data = user_data;
 
+	noti_cb_list_new->filtered = filtered;
+	noti_cb_list_new->filter_pkgname = pkgname ? strdup(pkgname) : NULL;
+	noti_cb_list_new->filter_type = type;
+	noti_cb_list_new->filter_applist = applist;
+
+	_noti_changed_monitor_filter(noti_cb_list_new, 1);
+
 	if (g_notification_cb_list == NULL) {
 		g_notification_cb_list = noti_cb_list_new;
 	} else {
@@ -2636,9 +3399,13 @@ notification_resister_changed_cb(void (*changed_cb)
 	return NOTIFICATION_ERROR_NONE;
 }
 
-EXPORT_API notification_error_e
-notification_unresister_changed_cb(void (*changed_cb)
-				   (void *data, notification_type_e type))
+static notification_error_e
+_notification_unresister_cb(void (*changed_cb)
+			    (void *data, notification_type_e type),
+			    void (*detailed_changed_cb)
+			    (void *data, notification_op_type_e op,
+			     const char *pkgname, notification_type_e type,
+			     const int *priv_ids, int num_priv_ids))
 {
 	notification_cb_list_s *noti_cb_list = NULL;
 	notification_cb_list_s *noti_cb_list_prev = NULL;
@@ -2655,7 +3422,8 @@ notification_unresister_changed_cb(void (*changed_cb)
 	}
 
 	do {
-		if (noti_cb_list->changed_cb == changed_cb) {
+		if (noti_cb_list->changed_cb == changed_cb
+		    && noti_cb_list->detailed_changed_cb == detailed_changed_cb) {
 			noti_cb_list_prev = noti_cb_list->prev;
 			noti_cb_list_next = noti_cb_list->next;
 
@@ -2673,10 +3441,14 @@ notification_unresister_changed_cb(void (*changed_cb)
 				noti_cb_list_next->prev = noti_cb_list_prev;
 			}
 
+			_noti_changed_monitor_filter(noti_cb_list, 0);
+
+			free(noti_cb_list->filter_pkgname);
 			free(noti_cb_list);
 
-			if (g_notification_cb_list == NULL)
+			if (g_notification_cb_list == NULL) {
 				_noti_chanaged_monitor_fini();
+			}
 
 			return NOTIFICATION_ERROR_NONE;
 		}
@@ -2686,22 +3458,234 @@ notification_unresister_changed_cb(void (*changed_cb)
 	return NOTIFICATION_ERROR_INVALID_DATA;
 }
 
+EXPORT_API notification_error_e
+notification_resister_changed_cb(void (*changed_cb)
+				 (void *data, notification_type_e type),
+				 void *user_data)
+{
+	return _notification_resister_cb(changed_cb, NULL, user_data, 0, NULL,
+					 NOTIFICATION_TYPE_NONE,
+					 NOTIFICATION_DISPLAY_APP_ALL);
+}
+
+EXPORT_API notification_error_e
+notification_unresister_changed_cb(void (*changed_cb)
+				   (void *data, notification_type_e type))
+{
+	return _notification_unresister_cb(changed_cb, NULL);
+}
+
+EXPORT_API notification_error_e
+notification_resister_detailed_changed_cb(void (*detailed_changed_cb)
+					  (void *data,
+					   notification_op_type_e op,
+					   const char *pkgname,
+					   notification_type_e type,
+					   const int *priv_ids,
+					   int num_priv_ids),
+					  void *user_data)
+{
+	if (detailed_changed_cb == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	return _notification_resister_cb(NULL, detailed_changed_cb,
+					 user_data, 0, NULL,
+					 NOTIFICATION_TYPE_NONE,
+					 NOTIFICATION_DISPLAY_APP_ALL);
+}
+
+EXPORT_API notification_error_e
+notification_resister_filtered_changed_cb(void (*detailed_changed_cb)
+					  (void *data,
+					   notification_op_type_e op,
+					   const char *pkgname,
+					   notification_type_e type,
+					   const int *priv_ids,
+					   int num_priv_ids),
+					  const char *pkgname,
+					  notification_type_e type,
+					  int applist,
+					  void *user_data)
+{
+	int applist_bits[NOTI_CHANGED_APPLIST_NUM] = NOTI_CHANGED_APPLIST;
+	int known_applist = 0;
+	int i = 0;
+
+	if (detailed_changed_cb == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	if (type < NOTIFICATION_TYPE_NONE || type >= NOTIFICATION_TYPE_MAX) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	if (pkgname != NULL && pkgname[0] == '\0') {
+		pkgname = NULL;
+	}
+
+	/* Package name is quoted in match rule, which has room for it */
+	if (pkgname != NULL && strlen(pkgname) >= NOTI_PKGNAME_LEN) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	for (i = 0; i < NOTI_CHANGED_APPLIST_NUM; i++) {
+		known_applist |= applist_bits[i];
+	}
+
+	if (applist != NOTIFICATION_DISPLAY_APP_ALL
+	    && (applist & known_applist) == 0) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	return _notification_resister_cb(NULL, detailed_changed_cb,
+					 user_data, 1, pkgname, type,
+					 applist);
+}
+
+EXPORT_API notification_error_e
+notification_unresister_detailed_changed_cb(void (*detailed_changed_cb)
+					    (void *data,
+					     notification_op_type_e op,
+					     const char *pkgname,
+					     notification_type_e type,
+					     const int *priv_ids,
+					     int num_priv_ids))
+{
+	if (detailed_changed_cb == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	return _notification_unresister_cb(NULL, detailed_changed_cb);
+}
+
+EXPORT_API notification_error_e notification_set_changed_coalescing(int msec)
+{
+	int pending = 0;
+
+	if (msec < 0) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	pthread_mutex_lock(&g_changed_lock);
+	g_changed_window = msec;
+	pending = g_changed_num > 0;
+	pthread_mutex_unlock(&g_changed_lock);
+
+	/* Send pending changes at once when coalescing is off */
+	if (msec == 0 && pending) {
+		_notification_changed_flush();
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+EXPORT_API notification_error_e notification_set_ongoing_update_interval(int msec)
+{
+	return notification_ongoing_set_interval(msec);
+}
+
+EXPORT_API notification_error_e notification_ongoing_channel_open(void)
+{
+	return notification_shm_reader_open(NOTIFICATION_ONGOING_CHANNEL_OPTION_NONE);
+}
+
+EXPORT_API notification_error_e notification_ongoing_channel_open_ex(int option)
+{
+	if (option & ~NOTIFICATION_ONGOING_CHANNEL_OPTION_EXCLUSIVE) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	return notification_shm_reader_open(option);
+}
+
+EXPORT_API notification_error_e
+notification_ongoing_channel_read(void (*update_cb)(void *data,
+						    notification_ongoing_update_type_e type,
+						    const char *pkgname,
+						    int priv_id, double value),
+				  void *user_data, int timeout_msec)
+{
+	return notification_shm_reader_read(update_cb, user_data,
+					    timeout_msec);
+}
+
+EXPORT_API notification_error_e notification_ongoing_channel_close(void)
+{
+	return notification_shm_reader_close();
+}
+
 EXPORT_API notification_error_e
 notification_resister_badge_changed_cb(void (*changed_cb)
 				       (void *data, const char *pkgname,
-					int group_id), void *user_data)
+					int group_id, int count), void *user_data)
 {
-	// Add DBus signal handler
+	notification_badge_cb_list_s *badge_cb_list_new = NULL;
+	notification_badge_cb_list_s *badge_cb_list = NULL;
+
+	if (changed_cb == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	if (!g_dbus_handle) {
+		g_dbus_handle = _noti_changed_monitor_init();
+		if (!g_dbus_handle)
+			return NOTIFICATION_ERROR_FROM_DBUS;
+	}
+
+	badge_cb_list_new = calloc(1, sizeof(notification_badge_cb_list_s));
+	if (badge_cb_list_new == NULL) {
+		_noti_chanaged_monitor_fini();
+		return NOTIFICATION_ERROR_NO_MEMORY;
+	}
+
+	badge_cb_list_new->changed_cb = changed_cb;
+	badge_cb_list_new->data = user_data;
+
+	if (g_notification_badge_cb_list == NULL) {
+		_noti_changed_monitor_match(NOTI_CHANGED_BADGE, "", 1);
+		g_notification_badge_cb_list = badge_cb_list_new;
+	} else {
+		badge_cb_list = g_notification_badge_cb_list;
+
+		while (badge_cb_list->next != NULL) {
+			badge_cb_list = badge_cb_list->next;
+		}
+
+		badge_cb_list->next = badge_cb_list_new;
+	}
+
 	return NOTIFICATION_ERROR_NONE;
 }
 
 EXPORT_API notification_error_e
 notification_unresister_badge_changed_cb(void (*changed_cb)
 					 (void *data, const char *pkgname,
-					  int group_id))
+					  int group_id, int count))
 {
-	// Del DBus signal handler
-	return NOTIFICATION_ERROR_NONE;
+	notification_badge_cb_list_s **badge_cb_list = NULL;
+	notification_badge_cb_list_s *badge_cb_list_del = NULL;
+
+	badge_cb_list = &g_notification_badge_cb_list;
+	while (*badge_cb_list != NULL) {
+		if ((*badge_cb_list)->changed_cb == changed_cb) {
+			badge_cb_list_del = *badge_cb_list;
+			*badge_cb_list = badge_cb_list_del->next;
+
+			free(badge_cb_list_del);
+
+			if (g_notification_badge_cb_list == NULL) {
+				_noti_changed_monitor_match(NOTI_CHANGED_BADGE, "", 0);
+				_noti_chanaged_monitor_fini();
+			}
+
+			return NOTIFICATION_ERROR_NONE;
+		}
+
+		badge_cb_list = &(*badge_cb_list)->next;
+	}
+
+	return NOTIFICATION_ERROR_INVALID_DATA;
 }
 
 EXPORT_API notification_error_e notification_get_count(notification_type_e type,
@@ -2726,14 +3710,54 @@ EXPORT_API notification_error_e notification_get_count(notification_type_e type,
 	return NOTIFICATION_ERROR_NONE;
 }
 
+/* Check fetch_option is bitwise OR of NOTIFICATION_FETCH_OPTION_XXX */
+static int _notification_check_fetch_option(int fetch_option)
+{
+	if (fetch_option & ~(NOTIFICATION_FETCH_OPTION_SUMMARY
+			     | NOTIFICATION_FETCH_OPTION_ARENA)) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
 EXPORT_API notification_error_e notification_get_list(notification_type_e type,
 						      int count,
 						      notification_list_h *list)
+{
+	return notification_get_grouping_list(type, count, list);
+}
+
+EXPORT_API notification_error_e
+notification_get_grouping_list(notification_type_e type, int count,
+			       notification_list_h * list)
+{
+	/* Other count than -1 and positive one gave one row */
+	if (count == 0 || count < -1) {
+		count = 1;
+	}
+
+	return notification_get_grouping_list_ex(type, count,
+						 NOTIFICATION_FETCH_OPTION_NONE,
+						 list);
+}
+
+EXPORT_API notification_error_e
+notification_get_grouping_list_ex(notification_type_e type, int count,
+				  int fetch_option,
+				  notification_list_h * list)
 {
 	notification_list_h get_list = NULL;
 	int ret = 0;
 
-	ret = notification_noti_get_grouping_list(type, count, &get_list);
+	if (list == NULL || count == 0 || count < -1
+	    || _notification_check_fetch_option(fetch_option) !=
+	    NOTIFICATION_ERROR_NONE) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	ret = notification_noti_get_grouping_list(type, count, fetch_option,
+						  &get_list);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		return ret;
 	}
@@ -2744,13 +3768,33 @@ EXPORT_API notification_error_e notification_get_list(notification_type_e type,
 }
 
 EXPORT_API notification_error_e
-notification_get_grouping_list(notification_type_e type, int count,
-			       notification_list_h * list)
+notification_get_grouping_list_page(notification_type_e type, int count,
+				    notification_page_token_s * token,
+				    notification_list_h * list)
+{
+	return notification_get_grouping_list_page_ex(type, count,
+						      NOTIFICATION_FETCH_OPTION_NONE,
+						      token, list);
+}
+
+EXPORT_API notification_error_e
+notification_get_grouping_list_page_ex(notification_type_e type, int count,
+				       int fetch_option,
+				       notification_page_token_s * token,
+				       notification_list_h * list)
 {
 	notification_list_h get_list = NULL;
 	int ret = 0;
 
-	ret = notification_noti_get_grouping_list(type, count, &get_list);
+	if (token == NULL || list == NULL || count == 0 || count < -1
+	    || _notification_check_fetch_option(fetch_option) !=
+	    NOTIFICATION_ERROR_NONE) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	ret = notification_noti_get_grouping_list_page(type, count,
+						       fetch_option, token,
+						       &get_list);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		return ret;
 	}
@@ -2765,13 +3809,37 @@ EXPORT_API notification_error_e notification_get_detail_list(const char *pkgname
 							     int priv_id,
 							     int count,
 							     notification_list_h *list)
+{
+	/* Other count than -1 and positive one gave one row */
+	if (count == 0 || count < -1) {
+		count = 1;
+	}
+
+	return notification_get_detail_list_ex(pkgname, group_id, priv_id,
+					       count,
+					       NOTIFICATION_FETCH_OPTION_NONE,
+					       list);
+}
+
+EXPORT_API notification_error_e notification_get_detail_list_ex(const char *pkgname,
+								int group_id,
+								int priv_id,
+								int count,
+								int fetch_option,
+								notification_list_h *list)
 {
 	notification_list_h get_list = NULL;
 	int ret = 0;
 
+	if (list == NULL || count == 0 || count < -1
+	    || _notification_check_fetch_option(fetch_option) !=
+	    NOTIFICATION_ERROR_NONE) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
 	ret =
 	    notification_noti_get_detail_list(pkgname, group_id, priv_id, count,
-					      &get_list);
+					      fetch_option, &get_list);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		return ret;
 	}
@@ -2781,6 +3849,80 @@ EXPORT_API notification_error_e notification_get_detail_list(const char *pkgname
 	return NOTIFICATION_ERROR_NONE;
 }
 
+EXPORT_API notification_error_e notification_cursor_open_grouping(notification_type_e type,
+								  notification_cursor_h *cursor)
+{
+	return notification_cursor_open_grouping_ex(type,
+						    NOTIFICATION_FETCH_OPTION_NONE,
+						    cursor);
+}
+
+EXPORT_API notification_error_e notification_cursor_open_grouping_ex(notification_type_e type,
+								     int fetch_option,
+								     notification_cursor_h *cursor)
+{
+	if (cursor == NULL
+	    || _notification_check_fetch_option(fetch_option) !=
+	    NOTIFICATION_ERROR_NONE) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	/* Notifications of cursor are freed one by one, never in arena */
+	return notification_noti_cursor_open_grouping(type, -1, 0,
+						      fetch_option &
+						      ~NOTIFICATION_FETCH_OPTION_ARENA,
+						      cursor);
+}
+
+EXPORT_API notification_error_e notification_cursor_open_detail(const char *pkgname,
+								int group_id,
+								int priv_id,
+								notification_cursor_h *cursor)
+{
+	return notification_cursor_open_detail_ex(pkgname, group_id, priv_id,
+						  NOTIFICATION_FETCH_OPTION_NONE,
+						  cursor);
+}
+
+EXPORT_API notification_error_e notification_cursor_open_detail_ex(const char *pkgname,
+								   int group_id,
+								   int priv_id,
+								   int fetch_option,
+								   notification_cursor_h *cursor)
+{
+	if (cursor == NULL
+	    || _notification_check_fetch_option(fetch_option) !=
+	    NOTIFICATION_ERROR_NONE) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	/* Notifications of cursor are freed one by one, never in arena */
+	return notification_noti_cursor_open_detail(pkgname, group_id, priv_id,
+						    -1,
+						    fetch_option &
+						    ~NOTIFICATION_FETCH_OPTION_ARENA,
+						    cursor);
+}
+
+EXPORT_API notification_error_e notification_cursor_next(notification_cursor_h cursor,
+							 notification_h *noti)
+{
+	if (cursor == NULL || noti == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	return notification_noti_cursor_next(cursor, noti);
+}
+
+EXPORT_API notification_error_e notification_cursor_close(notification_cursor_h cursor)
+{
+	if (cursor == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	return notification_noti_cursor_close(cursor);
+}
+
 EXPORT_API notification_error_e notification_free_list(notification_list_h list)
 {
 	notification_list_h cur_list = NULL;
@@ -2795,9 +3937,15 @@ EXPORT_API notification_error_e notification_free_list(notification_list_h list)
 
 	while (cur_list != NULL) {
 		noti = notification_list_get_data(cur_list);
-		cur_list = notification_list_remove(cur_list, noti);
 
-		notification_free(noti);
+		/* Detached notification is freed by caller. Others are freed
+		 * before removed, so remove does not detach them and arena is
+		 * released with the last item */
+		if (noti->arena == NULL || !noti->detached) {
+			notification_free(noti);
+		}
+
+		cur_list = notification_list_remove(cur_list, noti);
 	}
 
 	return NOTIFICATION_ERROR_NONE;
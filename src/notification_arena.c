@@ -0,0 +1,187 @@
+/*
+ *  libnotification
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Seungtaek Chung <seungtaek.chung@samsung.com>, Mi-Ju Lee <miju52.lee@samsung.com>, Xi Zhichan <zhichan.xi@samsung.com>, Youngsub Ko <ys4610.ko@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <notification_debug.h>
+#include <notification_arena.h>
+
+#define NOTIFICATION_ARENA_ALIGN(size) (((size) + 7) & ~(size_t)7)
+/* Chunks grow twice up to max, so an arena has few of them */
+#define NOTIFICATION_ARENA_CHUNK_MIN (16 * 1024)
+#define NOTIFICATION_ARENA_CHUNK_MAX (1024 * 1024)
+
+typedef struct _notification_arena_chunk notification_arena_chunk_s;
+
+struct _notification_arena_chunk {
+	notification_arena_chunk_s *next;
+	char *data;
+	size_t size;
+	size_t used;
+};
+
+struct _notification_arena {
+	int ref;
+	notification_arena_chunk_s *chunks;	/* Newest first */
+	size_t chunk_size;	/* Size of next chunk */
+};
+
+static notification_arena_chunk_s *_notification_arena_chunk_create(size_t size)
+{
+	notification_arena_chunk_s *chunk = NULL;
+	size_t header = NOTIFICATION_ARENA_ALIGN(sizeof(notification_arena_chunk_s));
+
+	chunk = malloc(header + size);
+	if (chunk == NULL) {
+		NOTIFICATION_ERR("NO MEMORY");
+		return NULL;
+	}
+
+	chunk->next = NULL;
+	chunk->data = (char *)chunk + header;
+	chunk->size = size;
+	chunk->used = 0;
+
+	return chunk;
+}
+
+notification_arena_s *notification_arena_create(void)
+{
+	notification_arena_s *arena = NULL;
+
+	arena = calloc(1, sizeof(notification_arena_s));
+	if (arena == NULL) {
+		NOTIFICATION_ERR("NO MEMORY");
+		return NULL;
+	}
+
+	arena->ref = 1;
+	arena->chunk_size = NOTIFICATION_ARENA_CHUNK_MIN;
+
+	return arena;
+}
+
+void notification_arena_ref(notification_arena_s * arena)
+{
+	__sync_fetch_and_add(&arena->ref, 1);
+}
+
+void notification_arena_unref(notification_arena_s * arena)
+{
+	notification_arena_chunk_s *chunk = NULL;
+
+	if (__sync_sub_and_fetch(&arena->ref, 1) > 0) {
+		return;
+	}
+
+	while (arena->chunks != NULL) {
+		chunk = arena->chunks;
+		arena->chunks = chunk->next;
+		free(chunk);
+	}
+
+	free(arena);
+}
+
+void *notification_arena_alloc(notification_arena_s * arena, size_t size)
+{
+	notification_arena_chunk_s *chunk = NULL;
+	void *data = NULL;
+
+	size = NOTIFICATION_ARENA_ALIGN(size);
+
+	chunk = arena->chunks;
+	if (chunk == NULL || chunk->used + size > chunk->size) {
+		if (size > arena->chunk_size / 4) {
+			/* Large data has its own chunk, behind current one
+			 * not to waste room left in it */
+			chunk = _notification_arena_chunk_create(size);
+			if (chunk == NULL) {
+				return NULL;
+			}
+
+			if (arena->chunks != NULL) {
+				chunk->next = arena->chunks->next;
+				arena->chunks->next = chunk;
+			} else {
+				arena->chunks = chunk;
+			}
+		} else {
+			chunk = _notification_arena_chunk_create(arena->chunk_size);
+			if (chunk == NULL) {
+				return NULL;
+			}
+
+			chunk->next = arena->chunks;
+			arena->chunks = chunk;
+
+			if (arena->chunk_size < NOTIFICATION_ARENA_CHUNK_MAX) {
+				arena->chunk_size *= 2;
+			}
+		}
+	}
+
+	data = chunk->data + chunk->used;
+	chunk->used += size;
+
+	memset(data, 0, size);
+
+	return data;
+}
+
+char *notification_arena_strdup(notification_arena_s * arena, const char *str)
+{
+	return notification_arena_memdup(arena, str, strlen(str) + 1);
+}
+
+void *notification_arena_memdup(notification_arena_s * arena, const void *data,
+				size_t size)
+{
+	void *new_data = NULL;
+
+	new_data = notification_arena_alloc(arena, size);
+	if (new_data != NULL) {
+		memcpy(new_data, data, size);
+	}
+
+	return new_data;
+}
+
+void notification_arena_free(notification_arena_s * arena, void *data)
+{
+	notification_arena_chunk_s *chunk = NULL;
+
+	if (data == NULL) {
+		return;
+	}
+
+	if (arena != NULL) {
+		for (chunk = arena->chunks; chunk != NULL; chunk = chunk->next) {
+			if ((char *)data >= chunk->data
+			    && (char *)data < chunk->data + chunk->used) {
+				return;
+			}
+		}
+	}
+
+	free(data);
+}
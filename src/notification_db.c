@@ -23,6 +23,8 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
 
 #include <sqlite3.h>
 #include <db-util.h>
@@ -33,6 +35,246 @@
 
 #define SDFTET "/opt/dbspace/.notification_noti.db"
 
+#ifndef DBPROFILE
+#define DBPROFILE "wal"
+#endif
+
+/* Environment variable to select other profile, for benchmark */
+#define NOTIFICATION_DB_PROFILE_ENV "NOTIFICATION_DB_PROFILE"
+
+/* Storage profile applied to every new connection.
+ * journal_mode is stored in DB file, so switching it converts an existing
+ * DB once. It needs no other connection open, otherwise it is retried by
+ * next connection. */
+typedef struct _notification_db_profile {
+	const char *name;
+	const char *journal_mode;
+	const char *pragma;
+} notification_db_profile_s;
+
+static const notification_db_profile_s g_db_profiles[] = {
+	/* Rollback journal kept between transactions, as before */
+	{"persist", "PRAGMA journal_mode = PERSIST",
+	 "PRAGMA synchronous = FULL;"
+	 "PRAGMA temp_store = DEFAULT;"},
+	/* Readers do not block on writer. Commit is durable once WAL is
+	 * checkpointed, a power loss may drop only the last commits */
+	{"wal", "PRAGMA journal_mode = WAL",
+	 "PRAGMA synchronous = NORMAL;"
+	 "PRAGMA cache_size = 256;"
+	 "PRAGMA mmap_size = 1048576;"
+	 "PRAGMA temp_store = MEMORY;"
+	 "PRAGMA wal_autocheckpoint = 256;"},
+	/* No fsync at all, only for measuring */
+	{"benchmark", "PRAGMA journal_mode = WAL",
+	 "PRAGMA synchronous = OFF;"
+	 "PRAGMA cache_size = 2000;"
+	 "PRAGMA mmap_size = 16777216;"
+	 "PRAGMA temp_store = MEMORY;"
+	 "PRAGMA wal_autocheckpoint = 1000;"},
+};
+
+/* Connection shared by every module of this process. It is opened on first
+ * use and closed by notification_db_fini(). g_db_lock serializes access, so
+ * one thread's statements never run inside another thread's transaction. */
+static sqlite3 *g_db = NULL;
+static pthread_mutex_t g_db_lock;
+static pthread_once_t g_db_once = PTHREAD_ONCE_INIT;
+static int g_db_initialized = 0;
+static int g_db_upgraded = 0;	/* Schema of g_db is NOTIFICATION_DB_VERSION */
+
+/* Wait for lock of other process, e.g. while it upgrades DB */
+#define NOTIFICATION_DB_BUSY_TIMEOUT 2000
+
+/* Prepared statements of the shared connection, keyed by query template.
+ * Only touched while g_db_lock is held. */
+#define NOTIFICATION_STMT_CACHE_MAX 32
+
+typedef struct _notification_stmt_cache {
+	char *query;
+	sqlite3_stmt *stmt;
+	int in_use;
+} notification_stmt_cache_s;
+
+static notification_stmt_cache_s g_stmt_cache[NOTIFICATION_STMT_CACHE_MAX];
+static int g_stmt_cache_evict = 0;
+
+/* Cursor statements are not cached and live across releases of g_db_lock.
+ * notification_db_fini() while a cursor is open closes the connection
+ * when the last cursor statement is finalized. */
+static int g_db_num_cursors = 0;
+static int g_db_fini_pending = 0;
+
+/* Bundle columns of noti_list, converted to binary by upgrade step 4 */
+static const char *g_db_bundle_columns[] = {
+	"image_path", "b_text", "b_key", "b_format_args", "args", "group_args",
+	"b_execute_option", "b_service_responding",
+	"b_service_single_launch", "b_service_multi_launch",
+};
+
+/* Text columns of noti_list added by upgrade step 5, in order of
+ * notification_text_type_e. b_text is split to text_xxx, b_key to key_xxx */
+static const char *g_db_text_columns[] = {
+	"title", "content", "content_off",
+	"group_title", "group_content", "group_content_off",
+};
+
+static int _notification_db_convert_bundle_blob(sqlite3 * db);
+static int _notification_db_convert_text_columns(sqlite3 * db);
+
+/* Key of noti_count in row of noti_list */
+#define NOTIFICATION_DB_COUNT_KEY(row) \
+	"caller_pkgname = " row ".caller_pkgname " \
+	"and group_id = " row ".group_id " \
+	"and internal_group_id = " row ".internal_group_id " \
+	"and type = " row ".type " \
+	"and flag_simmode = " row ".flag_simmode"
+
+#define NOTIFICATION_DB_COUNT_INC \
+	"insert or ignore into noti_count values (" \
+	"new.caller_pkgname, new.group_id, new.internal_group_id, " \
+	"new.type, new.flag_simmode, 0); " \
+	"update noti_count set count = count + 1 where " \
+	NOTIFICATION_DB_COUNT_KEY("new") "; "
+
+#define NOTIFICATION_DB_COUNT_DEC \
+	"update noti_count set count = count - 1 where " \
+	NOTIFICATION_DB_COUNT_KEY("old") "; " \
+	"delete from noti_count where count <= 0 and " \
+	NOTIFICATION_DB_COUNT_KEY("old") "; "
+
+/* Same triggers are created by install script, keep them equal */
+#define NOTIFICATION_DB_COUNT_TRIGGERS \
+	"create trigger if not exists noti_count_insert " \
+	"after insert on noti_list begin " \
+	NOTIFICATION_DB_COUNT_INC \
+	"end;" \
+	"create trigger if not exists noti_count_delete " \
+	"after delete on noti_list begin " \
+	NOTIFICATION_DB_COUNT_DEC \
+	"end;" \
+	"create trigger if not exists noti_count_update " \
+	"after update of caller_pkgname, group_id, internal_group_id, " \
+	"type, flag_simmode on noti_list begin " \
+	NOTIFICATION_DB_COUNT_DEC \
+	NOTIFICATION_DB_COUNT_INC \
+	"end;"
+
+/* Schema changes applied to DB created by an older package.
+ * PRAGMA user_version holds the number of steps already applied,
+ * new steps are appended at the end only. A step runs its query,
+ * then its convert function if any. */
+typedef struct _notification_db_upgrade {
+	const char *query;
+	int (*convert) (sqlite3 * db);
+} notification_db_upgrade_s;
+
+static const notification_db_upgrade_s g_db_upgrade[] = {
+	/* 1 : ID sequences, seeded lazily from noti_list */
+	{"create table if not exists noti_id_seq ("
+	 "name TEXT NOT NULL, "
+	 "seq INTEGER NOT NULL default 0, "
+	 "PRIMARY KEY (name))", NULL},
+	/* 2 : indexes for where clauses of notification_noti.c */
+	{"create index if not exists noti_list_pkg_group_idx "
+	 "on noti_list (caller_pkgname, group_id, internal_group_id);"
+	 "create index if not exists noti_list_pkg_internal_group_idx "
+	 "on noti_list (caller_pkgname, internal_group_id);"
+	 "create index if not exists noti_list_title_group_idx "
+	 "on noti_list (title_key, group_id, internal_group_id);"
+	 "create index if not exists noti_list_type_simmode_idx "
+	 "on noti_list (type, flag_simmode);"
+	 "create index if not exists noti_list_simmode_type_idx "
+	 "on noti_list (flag_simmode, type)", NULL},
+	/* 3 : newest row of each group, for paged grouping list */
+	{"create index if not exists noti_list_internal_group_idx "
+	 "on noti_list (internal_group_id)", NULL},
+	/* 4 : bundle columns from bundle_encode text to binary blob */
+	{NULL, _notification_db_convert_bundle_blob},
+	/* 5 : text and key of each text type from b_text, b_key to columns */
+	{NULL, _notification_db_convert_text_columns},
+	/* 6 : row count of noti_list kept by triggers, for get_count */
+	{"create table if not exists noti_count ("
+	 "caller_pkgname TEXT NOT NULL, "
+	 "group_id INTEGER NOT NULL, "
+	 "internal_group_id INTEGER NOT NULL, "
+	 "type INTEGER NOT NULL, "
+	 "flag_simmode INTEGER NOT NULL, "
+	 "count INTEGER NOT NULL default 0, "
+	 "PRIMARY KEY (caller_pkgname, group_id, internal_group_id, "
+	 "type, flag_simmode));"
+	 NOTIFICATION_DB_COUNT_TRIGGERS
+	 "delete from noti_count;"
+	 "insert into noti_count "
+	 "select caller_pkgname, group_id, internal_group_id, "
+	 "type, flag_simmode, count(*) from noti_list "
+	 "group by caller_pkgname, group_id, internal_group_id, "
+	 "type, flag_simmode", NULL},
+};
+
+#define NOTIFICATION_DB_VERSION \
+	((int)(sizeof(g_db_upgrade) / sizeof(g_db_upgrade[0])))
+
+static void _notification_db_stmt_cache_clear(int finalize)
+{
+	int i = 0;
+
+	for (i = 0; i < NOTIFICATION_STMT_CACHE_MAX; i++) {
+		if (g_stmt_cache[i].query == NULL) {
+			continue;
+		}
+
+		if (finalize) {
+			sqlite3_finalize(g_stmt_cache[i].stmt);
+		}
+
+		free(g_stmt_cache[i].query);
+		g_stmt_cache[i].query = NULL;
+		g_stmt_cache[i].stmt = NULL;
+		g_stmt_cache[i].in_use = 0;
+	}
+}
+
+static void _notification_db_atfork_prepare(void)
+{
+	pthread_mutex_lock(&g_db_lock);
+}
+
+static void _notification_db_atfork_parent(void)
+{
+	pthread_mutex_unlock(&g_db_lock);
+}
+
+static void _notification_db_atfork_child(void)
+{
+	/* SQLite connections must not be used across fork().
+	 * Forget the parent's handle, child will open its own one. */
+	g_db = NULL;
+	g_db_upgraded = 0;
+	_notification_db_stmt_cache_clear(0);
+	g_db_num_cursors = 0;
+	g_db_fini_pending = 0;
+
+	pthread_mutex_unlock(&g_db_lock);
+}
+
+static void _notification_db_init_once(void)
+{
+	pthread_mutexattr_t attr;
+
+	/* Recursive, internal functions may acquire DB again */
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&g_db_lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+
+	pthread_atfork(_notification_db_atfork_prepare,
+		       _notification_db_atfork_parent,
+		       _notification_db_atfork_child);
+
+	g_db_initialized = 1;
+}
+
 sqlite3 *notification_db_open(const char *dbfile)
 {
 	int ret = 0;
@@ -66,6 +308,396 @@ int notification_db_close(sqlite3 ** db)
 	return NOTIFICATION_ERROR_NONE;
 }
 
+static const notification_db_profile_s *_notification_db_get_profile(void)
+{
+	const char *name = NULL;
+	int count = sizeof(g_db_profiles) / sizeof(g_db_profiles[0]);
+	int i = 0;
+
+	name = getenv(NOTIFICATION_DB_PROFILE_ENV);
+	if (name == NULL || name[0] == '\0') {
+		name = DBPROFILE;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (strcmp(g_db_profiles[i].name, name) == 0) {
+			return &g_db_profiles[i];
+		}
+	}
+
+	NOTIFICATION_ERR("Unknown DB profile %s, use %s", name, DBPROFILE);
+
+	for (i = 0; i < count; i++) {
+		if (strcmp(g_db_profiles[i].name, DBPROFILE) == 0) {
+			return &g_db_profiles[i];
+		}
+	}
+
+	return &g_db_profiles[0];
+}
+
+static void _notification_db_set_profile(sqlite3 * db)
+{
+	const notification_db_profile_s *profile = NULL;
+	int persist = 1;
+
+	profile = _notification_db_get_profile();
+
+	/* -wal and -shm files are made at install with group of DB. Keep
+	 * them at close, otherwise next app makes them with its own group,
+	 * which other apps may not open. */
+	sqlite3_file_control(db, "main", SQLITE_FCNTL_PERSIST_WAL, &persist);
+
+	/* Fails while other connection is open, keep current mode then */
+	if (notification_db_exec(db, profile->journal_mode) !=
+	    NOTIFICATION_ERROR_NONE) {
+		NOTIFICATION_INFO("Journal mode is not changed : %s",
+				  profile->journal_mode);
+	}
+
+	notification_db_exec(db, profile->pragma);
+}
+
+static int _notification_db_get_version(sqlite3 * db)
+{
+	sqlite3_stmt *stmt = NULL;
+	int version = -1;
+
+	if (sqlite3_prepare_v2(db, "PRAGMA user_version", -1, &stmt,
+			       NULL) != SQLITE_OK) {
+		return -1;
+	}
+
+	if (sqlite3_step(stmt) == SQLITE_ROW) {
+		version = sqlite3_column_int(stmt, 0);
+	}
+
+	sqlite3_finalize(stmt);
+
+	return version;
+}
+
+static int _notification_db_convert_bundle_blob(sqlite3 * db)
+{
+	sqlite3_stmt *select_stmt = NULL;
+	sqlite3_stmt *update_stmt = NULL;
+	char query[NOTIFICATION_QUERY_MAX] = { 0, };
+	bundle *b = NULL;
+	bundle_raw *raw = NULL;
+	int count = sizeof(g_db_bundle_columns) / sizeof(g_db_bundle_columns[0]);
+	int len = 0;
+	int ret = NOTIFICATION_ERROR_NONE;
+	int i = 0;
+
+	for (i = 0; i < count && ret == NOTIFICATION_ERROR_NONE; i++) {
+		/* Only text written by bundle_encode is left to convert */
+		snprintf(query, sizeof(query),
+			 "select rowid, %s from noti_list where typeof(%s) = 'text'",
+			 g_db_bundle_columns[i], g_db_bundle_columns[i]);
+		if (sqlite3_prepare_v2(db, query, -1, &select_stmt, NULL) !=
+		    SQLITE_OK) {
+			return NOTIFICATION_ERROR_FROM_DB;
+		}
+
+		snprintf(query, sizeof(query),
+			 "update noti_list set %s = ? where rowid = ?",
+			 g_db_bundle_columns[i]);
+		if (sqlite3_prepare_v2(db, query, -1, &update_stmt, NULL) !=
+		    SQLITE_OK) {
+			sqlite3_finalize(select_stmt);
+			return NOTIFICATION_ERROR_FROM_DB;
+		}
+
+		while (sqlite3_step(select_stmt) == SQLITE_ROW) {
+			raw = NULL;
+			len = 0;
+
+			/* Empty text was written for no bundle */
+			b = notification_db_column_bundle(select_stmt, 1);
+			if (b != NULL) {
+				bundle_encode_raw(b, &raw, &len);
+				bundle_free(b);
+			}
+
+			if (raw != NULL && len > 0) {
+				sqlite3_bind_blob(update_stmt, 1, raw, len,
+						  SQLITE_TRANSIENT);
+			} else {
+				sqlite3_bind_null(update_stmt, 1);
+			}
+			sqlite3_bind_int(update_stmt, 2,
+					 sqlite3_column_int(select_stmt, 0));
+
+			if (sqlite3_step(update_stmt) != SQLITE_DONE) {
+				ret = NOTIFICATION_ERROR_FROM_DB;
+			}
+			sqlite3_reset(update_stmt);
+
+			if (raw) {
+				free(raw);
+			}
+
+			if (ret != NOTIFICATION_ERROR_NONE) {
+				break;
+			}
+		}
+
+		sqlite3_finalize(update_stmt);
+		sqlite3_finalize(select_stmt);
+	}
+
+	return ret;
+}
+
+static int _notification_db_has_column(sqlite3 * db, const char *column)
+{
+	sqlite3_stmt *stmt = NULL;
+	const unsigned char *name = NULL;
+	int found = 0;
+
+	if (sqlite3_prepare_v2(db, "PRAGMA table_info(noti_list)", -1, &stmt,
+			       NULL) != SQLITE_OK) {
+		return 0;
+	}
+
+	/* 2nd column of table_info is name */
+	while (found == 0 && sqlite3_step(stmt) == SQLITE_ROW) {
+		name = sqlite3_column_text(stmt, 1);
+		if (name != NULL && strcmp((const char *)name, column) == 0) {
+			found = 1;
+		}
+	}
+
+	sqlite3_finalize(stmt);
+
+	return found;
+}
+
+static int _notification_db_convert_text_columns(sqlite3 * db)
+{
+	sqlite3_stmt *select_stmt = NULL;
+	sqlite3_stmt *update_stmt = NULL;
+	char query[NOTIFICATION_QUERY_MAX] = { 0, };
+	char column[32] = { 0, };
+	char buf_key[32] = { 0, };
+	bundle *b = NULL;
+	const char *prefix[2] = { "text", "key" };
+	const char *val = NULL;
+	int count = sizeof(g_db_text_columns) / sizeof(g_db_text_columns[0]);
+	int len = 0;
+	int ret = NOTIFICATION_ERROR_NONE;
+	int i = 0;
+	int j = 0;
+
+	/* Table created by new package has the columns already */
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < count; j++) {
+			snprintf(column, sizeof(column), "%s_%s", prefix[i],
+				 g_db_text_columns[j]);
+			if (_notification_db_has_column(db, column)) {
+				continue;
+			}
+
+			snprintf(query, sizeof(query),
+				 "alter table noti_list add column %s TEXT",
+				 column);
+			ret = notification_db_exec(db, query);
+			if (ret != NOTIFICATION_ERROR_NONE) {
+				return ret;
+			}
+		}
+	}
+
+	/* update noti_list set text_xxx = ?, ..., key_xxx = ?, ...,
+	 * b_text = NULL, b_key = NULL where rowid = ? */
+	len = snprintf(query, sizeof(query), "update noti_list set ");
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < count; j++) {
+			len += snprintf(query + len, sizeof(query) - len,
+					"%s_%s = ?, ", prefix[i],
+					g_db_text_columns[j]);
+		}
+	}
+	snprintf(query + len, sizeof(query) - len,
+		 "b_text = NULL, b_key = NULL where rowid = ?");
+
+	if (sqlite3_prepare_v2(db, "select rowid, b_text, b_key from noti_list "
+			       "where b_text is not null or b_key is not null",
+			       -1, &select_stmt, NULL) != SQLITE_OK) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	if (sqlite3_prepare_v2(db, query, -1, &update_stmt, NULL) != SQLITE_OK) {
+		sqlite3_finalize(select_stmt);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	while (ret == NOTIFICATION_ERROR_NONE
+	       && sqlite3_step(select_stmt) == SQLITE_ROW) {
+		for (i = 0; i < 2; i++) {
+			b = notification_db_column_bundle(select_stmt, i + 1);
+
+			for (j = 0; j < count; j++) {
+				val = NULL;
+				if (b != NULL) {
+					snprintf(buf_key, sizeof(buf_key), "%d", j);
+					val = bundle_get_val(b, buf_key);
+				}
+
+				if (val != NULL) {
+					sqlite3_bind_text(update_stmt,
+							  i * count + j + 1, val,
+							  -1, SQLITE_TRANSIENT);
+				} else {
+					sqlite3_bind_null(update_stmt,
+							  i * count + j + 1);
+				}
+			}
+
+			if (b != NULL) {
+				bundle_free(b);
+			}
+		}
+		sqlite3_bind_int(update_stmt, 2 * count + 1,
+				 sqlite3_column_int(select_stmt, 0));
+
+		if (sqlite3_step(update_stmt) != SQLITE_DONE) {
+			ret = NOTIFICATION_ERROR_FROM_DB;
+		}
+		sqlite3_reset(update_stmt);
+	}
+
+	sqlite3_finalize(update_stmt);
+	sqlite3_finalize(select_stmt);
+
+	return ret;
+}
+
+/* Upgrade schema to NOTIFICATION_DB_VERSION, return error if DB is
+ * still older. Queries of this version do not work on older schema. */
+static int _notification_db_upgrade(sqlite3 * db)
+{
+	char query[NOTIFICATION_QUERY_MAX] = { 0, };
+	int version = 0;
+
+	version = _notification_db_get_version(db);
+	if (version < 0) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+	if (version >= NOTIFICATION_DB_VERSION) {
+		return NOTIFICATION_ERROR_NONE;
+	}
+
+	/* Other process may be upgrading, check again in transaction */
+	if (notification_db_begin(db) != NOTIFICATION_ERROR_NONE) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	version = _notification_db_get_version(db);
+	if (version < 0) {
+		goto err;
+	}
+
+	for (; version < NOTIFICATION_DB_VERSION; version++) {
+		if (g_db_upgrade[version].query != NULL
+		    && notification_db_exec(db, g_db_upgrade[version].query) !=
+		    NOTIFICATION_ERROR_NONE) {
+			NOTIFICATION_ERR("DB upgrade to %d failed", version + 1);
+			goto err;
+		}
+
+		if (g_db_upgrade[version].convert != NULL
+		    && g_db_upgrade[version].convert(db) !=
+		    NOTIFICATION_ERROR_NONE) {
+			NOTIFICATION_ERR("DB convert to %d failed", version + 1);
+			goto err;
+		}
+	}
+
+	snprintf(query, sizeof(query), "PRAGMA user_version = %d",
+		 NOTIFICATION_DB_VERSION);
+	if (notification_db_exec(db, query) != NOTIFICATION_ERROR_NONE) {
+		goto err;
+	}
+
+	if (notification_db_commit(db) == NOTIFICATION_ERROR_NONE) {
+		return NOTIFICATION_ERROR_NONE;
+	}
+
+err:
+	/* Retried by next notification_db_acquire() */
+	notification_db_rollback(db);
+
+	return NOTIFICATION_ERROR_FROM_DB;
+}
+
+sqlite3 *notification_db_acquire(void)
+{
+	pthread_once(&g_db_once, _notification_db_init_once);
+
+	pthread_mutex_lock(&g_db_lock);
+
+	if (g_db == NULL) {
+		g_db = notification_db_open(DBPATH);
+		if (g_db == NULL) {
+			pthread_mutex_unlock(&g_db_lock);
+			return NULL;
+		}
+
+		sqlite3_busy_timeout(g_db, NOTIFICATION_DB_BUSY_TIMEOUT);
+		_notification_db_set_profile(g_db);
+	}
+
+	/* Fail until schema is upgraded, rather than run queries which
+	 * need new tables and columns on old schema */
+	if (g_db_upgraded == 0) {
+		if (_notification_db_upgrade(g_db) != NOTIFICATION_ERROR_NONE) {
+			NOTIFICATION_ERR("DB is not upgraded yet");
+			pthread_mutex_unlock(&g_db_lock);
+			return NULL;
+		}
+		g_db_upgraded = 1;
+	}
+
+	return g_db;
+}
+
+void notification_db_release(sqlite3 ** db)
+{
+	if (db == NULL || *db == NULL) {
+		return;
+	}
+
+	*db = NULL;
+
+	pthread_mutex_unlock(&g_db_lock);
+}
+
+void notification_db_fini(void)
+{
+	if (g_db_initialized == 0) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_db_lock);
+
+	if (g_db != NULL && g_db_num_cursors > 0) {
+		/* Closed by notification_db_finalize_cursor() */
+		g_db_fini_pending = 1;
+	} else if (g_db != NULL) {
+		_notification_db_stmt_cache_clear(1);
+		notification_db_close(&g_db);
+		g_db_upgraded = 0;
+	}
+
+	pthread_mutex_unlock(&g_db_lock);
+}
+
+static void __attribute__ ((destructor)) _notification_db_destructor(void)
+{
+	notification_db_fini();
+}
+
 int notification_db_exec(sqlite3 * db, const char *query)
 {
 	int ret = 0;
@@ -85,6 +717,266 @@ int notification_db_exec(sqlite3 * db, const char *query)
 	return NOTIFICATION_ERROR_NONE;
 }
 
+int notification_db_begin(sqlite3 * db)
+{
+	/* Take write lock at once, so the IDs read in transaction
+	 * can not be taken by other process before commit */
+	return notification_db_exec(db, "BEGIN IMMEDIATE");
+}
+
+int notification_db_commit(sqlite3 * db)
+{
+	return notification_db_exec(db, "COMMIT");
+}
+
+int notification_db_rollback(sqlite3 * db)
+{
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	/* Failed statement may have rolled back already */
+	if (sqlite3_get_autocommit(db)) {
+		return NOTIFICATION_ERROR_NONE;
+	}
+
+	return notification_db_exec(db, "ROLLBACK");
+}
+
+sqlite3_stmt *notification_db_prepare(sqlite3 * db, const char *query)
+{
+	sqlite3_stmt *stmt = NULL;
+	int ret = 0;
+	int i = 0;
+	int slot = -1;
+
+	if (db == NULL || query == NULL) {
+		return NULL;
+	}
+
+	/* Reuse cached statement of same query */
+	for (i = 0; i < NOTIFICATION_STMT_CACHE_MAX; i++) {
+		if (g_stmt_cache[i].query == NULL) {
+			if (slot < 0) {
+				slot = i;
+			}
+			continue;
+		}
+
+		if (g_stmt_cache[i].in_use == 0
+		    && sqlite3_db_handle(g_stmt_cache[i].stmt) == db
+		    && strcmp(g_stmt_cache[i].query, query) == 0) {
+			g_stmt_cache[i].in_use = 1;
+			return g_stmt_cache[i].stmt;
+		}
+	}
+
+	ret = sqlite3_prepare_v2(db, query, -1, &stmt, NULL);
+	if (ret != SQLITE_OK) {
+		NOTIFICATION_ERR("Prepare Query : %s", query);
+		NOTIFICATION_ERR("Prepare DB error(%d) : %s", ret,
+				 sqlite3_errmsg(db));
+		if (stmt) {
+			sqlite3_finalize(stmt);
+		}
+		return NULL;
+	}
+
+	/* Cache is full, evict one which is not in use */
+	for (i = 0; slot < 0 && i < NOTIFICATION_STMT_CACHE_MAX; i++) {
+		g_stmt_cache_evict =
+		    (g_stmt_cache_evict + 1) % NOTIFICATION_STMT_CACHE_MAX;
+
+		if (g_stmt_cache[g_stmt_cache_evict].in_use == 0) {
+			slot = g_stmt_cache_evict;
+
+			sqlite3_finalize(g_stmt_cache[slot].stmt);
+			free(g_stmt_cache[slot].query);
+			g_stmt_cache[slot].query = NULL;
+		}
+	}
+
+	/* Every cached statement is in use, return uncached one */
+	if (slot < 0) {
+		return stmt;
+	}
+
+	g_stmt_cache[slot].query = strdup(query);
+	if (g_stmt_cache[slot].query == NULL) {
+		return stmt;
+	}
+	g_stmt_cache[slot].stmt = stmt;
+	g_stmt_cache[slot].in_use = 1;
+
+	return stmt;
+}
+
+void notification_db_finalize(sqlite3_stmt * stmt)
+{
+	int i = 0;
+
+	if (stmt == NULL) {
+		return;
+	}
+
+	for (i = 0; i < NOTIFICATION_STMT_CACHE_MAX; i++) {
+		if (g_stmt_cache[i].query != NULL
+		    && g_stmt_cache[i].stmt == stmt) {
+			/* Keep cached statement for next use */
+			sqlite3_reset(stmt);
+			sqlite3_clear_bindings(stmt);
+			g_stmt_cache[i].in_use = 0;
+			return;
+		}
+	}
+
+	sqlite3_finalize(stmt);
+}
+
+sqlite3_stmt *notification_db_prepare_cursor(sqlite3 * db, const char *query)
+{
+	sqlite3_stmt *stmt = NULL;
+	int ret = 0;
+
+	if (db == NULL || query == NULL) {
+		return NULL;
+	}
+
+	ret = sqlite3_prepare_v2(db, query, -1, &stmt, NULL);
+	if (ret != SQLITE_OK) {
+		NOTIFICATION_ERR("Prepare Query : %s", query);
+		NOTIFICATION_ERR("Prepare DB error(%d) : %s", ret,
+				 sqlite3_errmsg(db));
+		if (stmt) {
+			sqlite3_finalize(stmt);
+		}
+		return NULL;
+	}
+
+	g_db_num_cursors++;
+
+	return stmt;
+}
+
+void notification_db_finalize_cursor(sqlite3_stmt * stmt)
+{
+	if (stmt == NULL) {
+		return;
+	}
+
+	sqlite3_finalize(stmt);
+
+	if (g_db_num_cursors > 0) {
+		g_db_num_cursors--;
+	}
+
+	/* notification_db_fini() was called while cursor was open */
+	if (g_db_num_cursors == 0 && g_db_fini_pending && g_db != NULL) {
+		_notification_db_stmt_cache_clear(1);
+		notification_db_close(&g_db);
+		g_db_upgraded = 0;
+		g_db_fini_pending = 0;
+	}
+}
+
+static int _notification_db_bind_index(sqlite3_stmt * stmt, const char *name)
+{
+	int index = 0;
+
+	index = sqlite3_bind_parameter_index(stmt, name);
+	if (index == 0) {
+		NOTIFICATION_ERR("Bind : invalid parameter name %s", name);
+	}
+
+	return index;
+}
+
+int notification_db_bind_text(sqlite3_stmt * stmt, const char *name,
+			      const char *str)
+{
+	int ret = 0;
+	int index = 0;
+
+	index = _notification_db_bind_index(stmt, name);
+	if (index == 0) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	ret =
+	    sqlite3_bind_text(stmt, index, NOTIFICATION_CHECK_STR(str), -1,
+			      SQLITE_TRANSIENT);
+	if (ret != SQLITE_OK) {
+		NOTIFICATION_ERR("Bind text : %s", NOTIFICATION_CHECK_STR(str));
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+int notification_db_bind_blob(sqlite3_stmt * stmt, const char *name,
+			      const void *data, int len)
+{
+	int ret = 0;
+	int index = 0;
+
+	index = _notification_db_bind_index(stmt, name);
+	if (index == 0) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	if (data == NULL || len <= 0) {
+		ret = sqlite3_bind_null(stmt, index);
+	} else {
+		ret = sqlite3_bind_blob(stmt, index, data, len,
+					SQLITE_TRANSIENT);
+	}
+	if (ret != SQLITE_OK) {
+		NOTIFICATION_ERR("Bind blob : %d bytes", len);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+int notification_db_bind_int(sqlite3_stmt * stmt, const char *name, int value)
+{
+	int ret = 0;
+	int index = 0;
+
+	index = _notification_db_bind_index(stmt, name);
+	if (index == 0) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	ret = sqlite3_bind_int(stmt, index, value);
+	if (ret != SQLITE_OK) {
+		NOTIFICATION_ERR("Bind int : %d", value);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+int notification_db_bind_double(sqlite3_stmt * stmt, const char *name,
+				double value)
+{
+	int ret = 0;
+	int index = 0;
+
+	index = _notification_db_bind_index(stmt, name);
+	if (index == 0) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	ret = sqlite3_bind_double(stmt, index, value);
+	if (ret != SQLITE_OK) {
+		NOTIFICATION_ERR("Bind double : %f", value);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
 char *notification_db_column_text(sqlite3_stmt * stmt, int col)
 {
 	const unsigned char *col_text = NULL;
@@ -97,10 +989,48 @@ char *notification_db_column_text(sqlite3_stmt * stmt, int col)
 	return strdup((char *)col_text);
 }
 
+char *notification_db_column_blob(sqlite3_stmt * stmt, int col, int *len)
+{
+	const void *col_blob = NULL;
+	char *data = NULL;
+	int col_len = 0;
+
+	*len = 0;
+
+	col_blob = sqlite3_column_blob(stmt, col);
+	col_len = sqlite3_column_bytes(stmt, col);
+	if (col_blob == NULL || col_len <= 0) {
+		return NULL;
+	}
+
+	data = malloc(col_len);
+	if (data == NULL) {
+		return NULL;
+	}
+
+	memcpy(data, col_blob, col_len);
+	*len = col_len;
+
+	return data;
+}
+
 bundle *notification_db_column_bundle(sqlite3_stmt * stmt, int col)
 {
 	const unsigned char *col_bundle = NULL;
+	int col_len = 0;
+
+	/* Binary written by bundle_encode_raw */
+	if (sqlite3_column_type(stmt, col) == SQLITE_BLOB) {
+		col_bundle = sqlite3_column_blob(stmt, col);
+		col_len = sqlite3_column_bytes(stmt, col);
+		if (col_bundle == NULL || col_len <= 0) {
+			return NULL;
+		}
+
+		return bundle_decode_raw(col_bundle, col_len);
+	}
 
+	/* Text written by bundle_encode, before DB upgrade */
 	col_bundle = sqlite3_column_text(stmt, col);
 	if (col_bundle == NULL || col_bundle[0] == '\0') {
 		return NULL;
@@ -22,26 +22,32 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <dbus/dbus.h>
 
 #include <notification_debug.h>
 #include <notification_group.h>
 #include <notification_db.h>
+#include <notification_internal.h>
+#include <notification_ipc.h>
 
 static int _notification_group_check_data_inserted(const char *pkgname,
 						   int group_id, sqlite3 * db)
 {
 	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
 	int ret = NOTIFICATION_ERROR_NONE, result = 0;
 
-	snprintf(query, sizeof(query),
-		 "select count(*) from noti_group_data where caller_pkgname = '%s' and group_id = %d",
-		 pkgname, group_id);
+	stmt = notification_db_prepare(db,
+				       "select count(*) from noti_group_data "
+				       "where caller_pkgname = $caller_pkgname and group_id = $group_id");
+	if (stmt == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
-	ret = sqlite3_prepare(db, query, strlen(query), &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Get count DB err(%d) : %s", ret,
-				 sqlite3_errmsg(db));
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$group_id",
+					group_id) != NOTIFICATION_ERROR_NONE) {
+		notification_db_finalize(stmt);
 		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
@@ -52,10 +58,10 @@ static int _notification_group_check_data_inserted(const char *pkgname,
 		result = 0;
 	}
 
-	NOTIFICATION_INFO("Check Data Inserted : query[%s], result : [%d]",
-			  query, result);
+	NOTIFICATION_INFO("Check Data Inserted : pkgname[%s] group_id[%d], result : [%d]",
+			  pkgname, group_id, result);
 
-	sqlite3_finalize(stmt);
+	notification_db_finalize(stmt);
 
 	if (result > 0) {
 		return NOTIFICATION_ERROR_ALREADY_EXIST_ID;
@@ -64,81 +70,198 @@ static int _notification_group_check_data_inserted(const char *pkgname,
 	return NOTIFICATION_ERROR_NONE;
 }
 
-notification_error_e notification_group_set_badge(const char *pkgname,
-						  int group_id, int count)
+static void _notification_group_badge_changed(const char *pkgname,
+					     int group_id, int count)
+{
+	DBusMessage *signal = NULL;
+	dbus_bool_t ret;
+
+	signal = dbus_message_new_signal(NOTI_DBUS_PATH, NOTI_DBUS_INTERFACE,
+					 NOTI_CHANGED_BADGE);
+	if (!signal) {
+		NOTIFICATION_ERR("Fail to dbus_message_new_signal");
+		return;
+	}
+
+	ret = dbus_message_append_args(signal,
+				       DBUS_TYPE_STRING, &pkgname,
+				       DBUS_TYPE_INT32, &group_id,
+				       DBUS_TYPE_INT32, &count,
+				       DBUS_TYPE_INVALID);
+	if (ret) {
+		ret = (notification_ipc_send(signal) == NOTIFICATION_ERROR_NONE);
+	}
+
+	if (!ret) {
+		NOTIFICATION_ERR("Fail to send badge : %s(%d) %d", pkgname,
+				 group_id, count);
+	}
+
+	dbus_message_unref(signal);
+}
+
+/* Upsert badge of pkgname and group_id in one transaction, query is
+ * the update of an existing row, which takes $badge. SQLite of the
+ * platform has no ON CONFLICT DO UPDATE, row is made by insert or ignore
+ * instead, under the write lock of BEGIN IMMEDIATE.
+ * The count after update is sent to badge changed callbacks. */
+static int _notification_group_update_badge(const char *pkgname,
+					    int group_id,
+					    const char *query, int badge)
 {
 	sqlite3 *db;
 	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
 	int ret = 0;
+	int count = 0;
 	int result = NOTIFICATION_ERROR_NONE;
 
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
-	/* Check pkgname & group_id */
-	ret = _notification_group_check_data_inserted(pkgname, group_id, db);
+	result = notification_db_begin(db);
+	if (result != NOTIFICATION_ERROR_NONE) {
+		notification_db_release(&db);
+		return result;
+	}
 
-	/* Make query */
-	if (ret == NOTIFICATION_ERROR_NONE) {
-		/* Insert if does not exist */
-		snprintf(query, sizeof(query), "insert into noti_group_data ("
-			 "caller_pkgname, group_id, badge, content, loc_content) values ("
-			 "'%s', %d, %d, '', '')", pkgname, group_id, count);
+	/* Insert if does not exist */
+	stmt = notification_db_prepare(db, "insert or ignore into noti_group_data ("
+				       "caller_pkgname, group_id, badge, content, loc_content) values ("
+				       "$caller_pkgname, $group_id, 0, '', '')");
+	if (stmt == NULL) {
+		result = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
+	}
 
-	} else {
-		/* Update if exist */
-		snprintf(query, sizeof(query), "update noti_group_data "
-			 "set badge = %d "
-			 "where caller_pkgname = '%s' and group_id = %d",
-			 count, pkgname, group_id);
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$group_id",
+					group_id) != NOTIFICATION_ERROR_NONE) {
+		result = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
 	}
 
-	ret = sqlite3_prepare_v2(db, query, -1, &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Insert Query : %s", query);
-		NOTIFICATION_ERR("Insert DB error(%d) : %s", ret,
+	ret = sqlite3_step(stmt);
+	if (ret != SQLITE_OK && ret != SQLITE_DONE) {
+		NOTIFICATION_ERR("Set badge DB error(%d) : %s", ret,
 				 sqlite3_errmsg(db));
-		if (stmt) {
-			sqlite3_finalize(stmt);
-		}
+		result = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
+	}
 
-		if (db) {
-			notification_db_close(&db);
-		}
-		return NOTIFICATION_ERROR_FROM_DB;
+	notification_db_finalize(stmt);
+
+	/* Update the row, which exists now */
+	stmt = notification_db_prepare(db, query);
+	if (stmt == NULL) {
+		result = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
+	}
+
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$group_id",
+					group_id) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$badge",
+					badge) != NOTIFICATION_ERROR_NONE) {
+		result = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
 	}
 
 	ret = sqlite3_step(stmt);
-	if (ret == SQLITE_OK || ret == SQLITE_DONE) {
-		result = NOTIFICATION_ERROR_NONE;
-	} else {
+	if (ret != SQLITE_OK && ret != SQLITE_DONE) {
+		NOTIFICATION_ERR("Set badge DB error(%d) : %s", ret,
+				 sqlite3_errmsg(db));
+		result = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
+	}
+
+	notification_db_finalize(stmt);
+
+	/* Read count in transaction, it may be clamped by query */
+	stmt = notification_db_prepare(db, "select badge from noti_group_data "
+				       "where caller_pkgname = $caller_pkgname and group_id = $group_id");
+	if (stmt == NULL) {
 		result = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
 	}
 
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$group_id",
+					group_id) != NOTIFICATION_ERROR_NONE) {
+		result = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
+	}
+
+	if (sqlite3_step(stmt) == SQLITE_ROW) {
+		count = sqlite3_column_int(stmt, 0);
+	}
+
+	notification_db_finalize(stmt);
+	stmt = NULL;
+
+	result = notification_db_commit(db);
+
+err:
 	if (stmt) {
-		sqlite3_finalize(stmt);
+		notification_db_finalize(stmt);
+	}
+
+	if (result != NOTIFICATION_ERROR_NONE) {
+		notification_db_rollback(db);
 	}
 
-	/* Close DB */
+	/* Release DB */
 	if (db) {
-		notification_db_close(&db);
+		notification_db_release(&db);
+	}
+
+	if (result == NOTIFICATION_ERROR_NONE) {
+		_notification_group_badge_changed(pkgname, group_id, count);
 	}
 
 	return result;
 }
 
+notification_error_e notification_group_set_badge(const char *pkgname,
+						  int group_id, int count)
+{
+	return _notification_group_update_badge(pkgname, group_id,
+						"update noti_group_data "
+						"set badge = $badge "
+						"where caller_pkgname = $caller_pkgname and group_id = $group_id",
+						count);
+}
+
+notification_error_e notification_group_add_badge(const char *pkgname,
+						  int group_id, int delta)
+{
+	/* Badge does not go below 0 */
+	return _notification_group_update_badge(pkgname, group_id,
+						"update noti_group_data "
+						"set badge = max(badge + $badge, 0) "
+						"where caller_pkgname = $caller_pkgname and group_id = $group_id",
+						delta);
+}
+
 notification_error_e notification_group_get_badge(const char *pkgname,
 						  int group_id, int *count)
 {
 	sqlite3 *db;
 	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
 	int ret = 0;
 	int col = 0;
+	int sum_all = 0;
 
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
 	/* Make query */
 	if (group_id == NOTIFICATION_GROUP_ID_NONE) {
@@ -149,34 +272,32 @@ notification_error_e notification_group_get_badge(const char *pkgname,
 
 		if (ret == NOTIFICATION_ERROR_NONE) {
 			/* Get all of pkgname count if none group id is not exist */
-			snprintf(query, sizeof(query),
-				 "select sum(badge) "
-				 "from noti_group_data "
-				 "where caller_pkgname = '%s'", pkgname);
-		} else {
-			/* Get none group id count */
-			snprintf(query, sizeof(query),
-				 "select badge "
-				 "from noti_group_data "
-				 "where caller_pkgname = '%s' and group_id = %d",
-				 pkgname, group_id);
+			sum_all = 1;
 		}
-	} else {
-		snprintf(query, sizeof(query),
-			 "select badge "
-			 "from noti_group_data "
-			 "where caller_pkgname = '%s' and group_id = %d",
-			 pkgname, group_id);
 	}
 
-	NOTIFICATION_INFO("Get badge : query[%s]", query);
+	if (sum_all == 1) {
+		stmt = notification_db_prepare(db, "select sum(badge) "
+					       "from noti_group_data "
+					       "where caller_pkgname = $caller_pkgname");
+	} else {
+		stmt = notification_db_prepare(db, "select badge "
+					       "from noti_group_data "
+					       "where caller_pkgname = $caller_pkgname and group_id = $group_id");
+	}
 
-	ret = sqlite3_prepare(db, query, strlen(query), &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Select Query : %s", query);
-		NOTIFICATION_ERR("Select DB error(%d) : %s", ret,
-				 sqlite3_errmsg(db));
+	if (stmt == NULL) {
+		notification_db_release(&db);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
+	ret = notification_db_bind_text(stmt, "$caller_pkgname", pkgname);
+	if (ret == NOTIFICATION_ERROR_NONE && sum_all == 0) {
+		ret = notification_db_bind_int(stmt, "$group_id", group_id);
+	}
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		notification_db_finalize(stmt);
+		notification_db_release(&db);
 		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
@@ -185,11 +306,11 @@ notification_error_e notification_group_get_badge(const char *pkgname,
 		*count = sqlite3_column_int(stmt, col++);
 	}
 
-	sqlite3_finalize(stmt);
+	notification_db_finalize(stmt);
 
-	// db close
+	/* Release DB */
 	if (db) {
-		notification_db_close(&db);
+		notification_db_release(&db);
 	}
 
 	return NOTIFICATION_ERROR_NONE;
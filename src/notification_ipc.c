@@ -0,0 +1,237 @@
+/*
+ *  libnotification
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Seungtaek Chung <seungtaek.chung@samsung.com>, Mi-Ju Lee <miju52.lee@samsung.com>, Xi Zhichan <zhichan.xi@samsung.com>, Youngsub Ko <ys4610.ko@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <dbus/dbus.h>
+
+#include <notification_error.h>
+#include <notification_debug.h>
+#include <notification_ipc.h>
+
+/* Connection for signals sent by this process. Sending only queues the
+ * message, drain thread writes the queue to the socket, so callers are
+ * not blocked by a busy bus. Queue is written at exit too. */
+static pthread_mutex_t g_ipc_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_ipc_cond = PTHREAD_COND_INITIALIZER;
+static DBusConnection *g_ipc_conn = NULL;
+static int g_ipc_queued = 0;
+static int g_ipc_thread = 0;
+static pthread_once_t g_ipc_once = PTHREAD_ONCE_INIT;
+
+static void *_notification_ipc_drain(void *data)
+{
+	DBusConnection *conn = NULL;
+
+	pthread_mutex_lock(&g_ipc_lock);
+
+	while (1) {
+		while (g_ipc_queued == 0 || g_ipc_conn == NULL) {
+			pthread_cond_wait(&g_ipc_cond, &g_ipc_lock);
+		}
+
+		g_ipc_queued = 0;
+		conn = dbus_connection_ref(g_ipc_conn);
+
+		pthread_mutex_unlock(&g_ipc_lock);
+
+		dbus_connection_flush(conn);
+
+		/* Nothing is received on this connection but messages of bus
+		 * itself, drop them */
+		while (dbus_connection_dispatch(conn) ==
+		       DBUS_DISPATCH_DATA_REMAINS) ;
+
+		dbus_connection_unref(conn);
+
+		pthread_mutex_lock(&g_ipc_lock);
+	}
+
+	return NULL;
+}
+
+static void _notification_ipc_exit(void)
+{
+	notification_ipc_flush();
+}
+
+static void _notification_ipc_atfork_prepare(void)
+{
+	pthread_mutex_lock(&g_ipc_lock);
+}
+
+static void _notification_ipc_atfork_parent(void)
+{
+	pthread_mutex_unlock(&g_ipc_lock);
+}
+
+static void _notification_ipc_atfork_child(void)
+{
+	/* Socket of parent's connection is shared with the parent and
+	 * drain thread is not running in child. Forget both, child
+	 * opens its own connection and starts its own thread. */
+	g_ipc_conn = NULL;
+	g_ipc_queued = 0;
+	g_ipc_thread = 0;
+	pthread_cond_init(&g_ipc_cond, NULL);
+
+	pthread_mutex_unlock(&g_ipc_lock);
+}
+
+static void _notification_ipc_init_once(void)
+{
+	pthread_atfork(_notification_ipc_atfork_prepare,
+		       _notification_ipc_atfork_parent,
+		       _notification_ipc_atfork_child);
+
+	atexit(_notification_ipc_exit);
+}
+
+void notification_ipc_init(void)
+{
+	pthread_once(&g_ipc_once, _notification_ipc_init_once);
+}
+
+DBusConnection *notification_ipc_open(void)
+{
+	DBusConnection *conn = NULL;
+	DBusError err;
+	const char *address = NULL;
+
+	dbus_threads_init_default();
+
+	dbus_error_init(&err);
+
+	address = getenv(NOTIFICATION_IPC_ADDRESS_ENV);
+	if (address != NULL && address[0] != '\0') {
+		conn = dbus_connection_open_private(address, &err);
+		if (conn != NULL && !dbus_bus_register(conn, &err)) {
+			dbus_connection_close(conn);
+			dbus_connection_unref(conn);
+			conn = NULL;
+		}
+	} else {
+		conn = dbus_bus_get_private(DBUS_BUS_SYSTEM, &err);
+	}
+
+	if (conn == NULL) {
+		NOTIFICATION_ERR("Fail to open bus : %s", err.message);
+		dbus_error_free(&err);
+		return NULL;
+	}
+
+	dbus_connection_set_exit_on_disconnect(conn, FALSE);
+
+	return conn;
+}
+
+/* Caller holds g_ipc_lock */
+static DBusConnection *_notification_ipc_get_connection(void)
+{
+	pthread_t thread;
+
+	/* Bus restarted, open again */
+	if (g_ipc_conn != NULL
+	    && !dbus_connection_get_is_connected(g_ipc_conn)) {
+		dbus_connection_close(g_ipc_conn);
+		dbus_connection_unref(g_ipc_conn);
+		g_ipc_conn = NULL;
+	}
+
+	if (g_ipc_conn == NULL) {
+		g_ipc_conn = notification_ipc_open();
+		if (g_ipc_conn == NULL) {
+			return NULL;
+		}
+	}
+
+	if (g_ipc_thread == 0) {
+		if (pthread_create(&thread, NULL, _notification_ipc_drain,
+				   NULL) != 0) {
+			NOTIFICATION_ERR("Fail to create drain thread");
+			return g_ipc_conn;
+		}
+
+		pthread_detach(thread);
+		g_ipc_thread = 1;
+	}
+
+	return g_ipc_conn;
+}
+
+int notification_ipc_send(DBusMessage * message)
+{
+	DBusConnection *conn = NULL;
+	dbus_bool_t ret;
+
+	if (message == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	notification_ipc_init();
+
+	pthread_mutex_lock(&g_ipc_lock);
+
+	conn = _notification_ipc_get_connection();
+	if (conn == NULL) {
+		pthread_mutex_unlock(&g_ipc_lock);
+		return NOTIFICATION_ERROR_FROM_DBUS;
+	}
+
+	ret = dbus_connection_send(conn, message, NULL);
+	if (ret) {
+		if (g_ipc_thread) {
+			g_ipc_queued = 1;
+			pthread_cond_signal(&g_ipc_cond);
+		} else {
+			/* No drain thread, write here as before */
+			dbus_connection_flush(conn);
+		}
+	}
+
+	pthread_mutex_unlock(&g_ipc_lock);
+
+	if (!ret) {
+		NOTIFICATION_ERR("Fail to dbus_connection_send");
+		return NOTIFICATION_ERROR_FROM_DBUS;
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+void notification_ipc_flush(void)
+{
+	DBusConnection *conn = NULL;
+
+	pthread_mutex_lock(&g_ipc_lock);
+	if (g_ipc_conn != NULL) {
+		conn = dbus_connection_ref(g_ipc_conn);
+	}
+	pthread_mutex_unlock(&g_ipc_lock);
+
+	if (conn != NULL) {
+		dbus_connection_flush(conn);
+		dbus_connection_unref(conn);
+	}
+}
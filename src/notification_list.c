@@ -20,71 +20,332 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 
 #include <notification.h>
 #include <notification_list.h>
 #include <notification_debug.h>
 #include <notification_internal.h>
+#include <notification_arena.h>
+
+#define NOTIFICATION_LIST_SIZE 16
+
+typedef struct _notification_list_array notification_list_array_s;
+
+/* Items of a list are kept in order in one array shared by them, so
+ * head, tail, count and nth item are found at once and append does not
+ * walk the list. Hash of pkgname and priv_id is built on first lookup. */
+struct _notification_list_array {
+	notification_list_h *items;
+	int first;		/* Items before first are removed from head */
+	int num;		/* Items from first to num - 1 are in list */
+	int size;
+
+	notification_list_h *buckets;
+	int num_buckets;	/* 0 until hash is built */
+	notification_list_array_s *hashed_prev;	/* Arrays having hash */
+	notification_list_array_s *hashed_next;
+
+	notification_arena_s *arena;	/* Memory of items and notifications */
+};
 
 struct _notification_list {
-	notification_list_h prev;
-	notification_list_h next;
+	notification_list_array_s *array;
+	int index;		/* Index in array->items */
+	notification_list_h hash_next;	/* Next item of same hash bucket */
+	unsigned int hash;	/* Hash of bucket item is in */
+	int in_arena;		/* Item is in arena of list */
 
 	notification_h noti;
 };
 
-notification_list_h _notification_list_create(void)
+/* Arrays having hash, notification changing its key is moved to bucket of
+ * new key in them. g_list_lock guards the arrays and their buckets. */
+static pthread_mutex_t g_list_lock = PTHREAD_MUTEX_INITIALIZER;
+static notification_list_array_s *g_list_hashed = NULL;
+
+static unsigned int _notification_list_hash(const char *pkgname, int priv_id)
+{
+	unsigned int hash = (unsigned int)priv_id * 2654435761u;
+
+	if (pkgname == NULL) {
+		return hash;
+	}
+
+	while (*pkgname != '\0') {
+		hash = hash * 31 + (unsigned char)*pkgname;
+		pkgname++;
+	}
+
+	return hash;
+}
+
+static notification_list_h _notification_list_create(notification_list_array_s *array,
+						     notification_h noti)
 {
 	notification_list_h list = NULL;
 
-	list = (notification_list_h) malloc(sizeof(struct _notification_list));
+	if (array->arena != NULL) {
+		list = notification_arena_alloc(array->arena,
+						sizeof(struct _notification_list));
+	} else {
+		list = (notification_list_h)
+		    malloc(sizeof(struct _notification_list));
+	}
 	if (list == NULL) {
 		NOTIFICATION_ERR("NO MEMORY");
 		return NULL;
 	}
 
-	list->prev = NULL;
-	list->next = NULL;
+	list->in_arena = array->arena != NULL;
+	list->array = array;
+	list->index = -1;
+	list->hash_next = NULL;
+	list->hash = 0;
 
-	list->noti = NULL;
+	list->noti = noti;
 
 	return list;
 }
 
-EXPORT_API notification_list_h notification_list_get_head(notification_list_h list)
+static notification_list_h *_notification_list_bucket(notification_list_array_s *array,
+						     unsigned int hash)
 {
-	notification_list_h cur_list = NULL;
+	return &array->buckets[hash & (array->num_buckets - 1)];
+}
 
-	if (list == NULL) {
-		NOTIFICATION_ERR("INVALID DATA : list == NULL");
-		return NULL;
+/* Caller holds g_list_lock */
+static void _notification_list_hash_link(notification_list_h list)
+{
+	notification_list_h *bucket = NULL;
+
+	/* Key is taken as it is now, hash is built after items are
+	 * appended and it follows notification_list_rehash() */
+	list->hash = _notification_list_hash(list->noti->caller_pkgname,
+					     list->noti->priv_id);
+	bucket = _notification_list_bucket(list->array, list->hash);
+	list->hash_next = *bucket;
+	*bucket = list;
+}
+
+static void _notification_list_hash_insert(notification_list_h list)
+{
+	if (list->array->num_buckets == 0) {
+		return;
 	}
 
-	cur_list = list;
+	pthread_mutex_lock(&g_list_lock);
+	_notification_list_hash_link(list);
+	pthread_mutex_unlock(&g_list_lock);
+}
 
-	while (cur_list->prev != NULL) {
-		cur_list = cur_list->prev;
+static void _notification_list_hash_remove(notification_list_h list)
+{
+	notification_list_h *bucket = NULL;
+
+	if (list->array->num_buckets == 0) {
+		return;
 	}
 
-	return cur_list;
+	pthread_mutex_lock(&g_list_lock);
+
+	bucket = _notification_list_bucket(list->array, list->hash);
+	while (*bucket != NULL) {
+		if (*bucket == list) {
+			*bucket = list->hash_next;
+			break;
+		}
+		bucket = &(*bucket)->hash_next;
+	}
+
+	list->hash_next = NULL;
+
+	pthread_mutex_unlock(&g_list_lock);
 }
 
-EXPORT_API notification_list_h notification_list_get_tail(notification_list_h list)
+/* Build hash again with twice buckets of items */
+static int _notification_list_hash_build(notification_list_array_s *array)
 {
-	notification_list_h cur_list = NULL;
+	notification_list_h *buckets = NULL;
+	int num_buckets = NOTIFICATION_LIST_SIZE;
+	int i = 0;
+
+	while (num_buckets < (array->num - array->first) * 2) {
+		num_buckets *= 2;
+	}
+
+	buckets = calloc(num_buckets, sizeof(notification_list_h));
+	if (buckets == NULL) {
+		NOTIFICATION_ERR("NO MEMORY");
+		return -1;
+	}
+
+	pthread_mutex_lock(&g_list_lock);
+
+	if (array->num_buckets == 0) {
+		array->hashed_prev = NULL;
+		array->hashed_next = g_list_hashed;
+		if (g_list_hashed != NULL) {
+			g_list_hashed->hashed_prev = array;
+		}
+		g_list_hashed = array;
+	}
+
+	free(array->buckets);
+	array->buckets = buckets;
+	array->num_buckets = num_buckets;
+
+	for (i = array->first; i < array->num; i++) {
+		_notification_list_hash_link(array->items[i]);
+	}
+
+	pthread_mutex_unlock(&g_list_lock);
+
+	return 0;
+}
+
+void notification_list_rehash(struct _notification *noti,
+			      const char *old_pkgname, int old_priv_id)
+{
+	notification_list_array_s *array = NULL;
+	notification_list_h *bucket = NULL;
+	notification_list_h moved = NULL;
+	notification_list_h list = NULL;
+	unsigned int old_hash = 0;
+
+	if (noti == NULL) {
+		return;
+	}
+
+	old_hash = _notification_list_hash(old_pkgname, old_priv_id);
+	if (old_hash == _notification_list_hash(noti->caller_pkgname,
+						noti->priv_id)) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_list_lock);
+
+	for (array = g_list_hashed; array != NULL; array = array->hashed_next) {
+		/* Take items of noti out of old bucket, then put them in
+		 * new one, which may be the same bucket */
+		bucket = _notification_list_bucket(array, old_hash);
+		while (*bucket != NULL) {
+			list = *bucket;
+			if (list->noti == noti && list->hash == old_hash) {
+				*bucket = list->hash_next;
+				list->hash_next = moved;
+				moved = list;
+			} else {
+				bucket = &list->hash_next;
+			}
+		}
+
+		while (moved != NULL) {
+			list = moved;
+			moved = list->hash_next;
+			_notification_list_hash_link(list);
+		}
+	}
+
+	pthread_mutex_unlock(&g_list_lock);
+}
+
+static void _notification_list_array_free(notification_list_array_s *array)
+{
+	if (array->arena != NULL) {
+		notification_arena_unref(array->arena);
+	}
+
+	if (array->num_buckets != 0) {
+		pthread_mutex_lock(&g_list_lock);
+		if (array->hashed_prev != NULL) {
+			array->hashed_prev->hashed_next = array->hashed_next;
+		} else {
+			g_list_hashed = array->hashed_next;
+		}
+		if (array->hashed_next != NULL) {
+			array->hashed_next->hashed_prev = array->hashed_prev;
+		}
+		pthread_mutex_unlock(&g_list_lock);
+	}
+
+	free(array->items);
+	free(array->buckets);
+	free(array);
+}
+
+void notification_list_set_arena(notification_list_h list,
+				 notification_arena_s * arena)
+{
+	if (list == NULL || list->array->arena != NULL) {
+		return;
+	}
+
+	notification_arena_ref(arena);
+	list->array->arena = arena;
+}
+
+static int _notification_list_array_append(notification_list_array_s *array,
+					   notification_list_h list)
+{
+	notification_list_h *items = NULL;
+	int size = 0;
+	int i = 0;
+
+	if (array->num == array->size) {
+		if (array->first > 0 && array->first >= array->size / 2) {
+			/* Reuse room of items removed from head */
+			memmove(array->items, &array->items[array->first],
+				sizeof(notification_list_h) *
+				(array->num - array->first));
+			array->num -= array->first;
+			array->first = 0;
+
+			for (i = 0; i < array->num; i++) {
+				array->items[i]->index = i;
+			}
+		} else {
+			size = array->size ? array->size * 2 :
+			    NOTIFICATION_LIST_SIZE;
+			items = realloc(array->items,
+					sizeof(notification_list_h) * size);
+			if (items == NULL) {
+				NOTIFICATION_ERR("NO MEMORY");
+				return -1;
+			}
+
+			array->items = items;
+			array->size = size;
+		}
+	}
 
+	list->index = array->num;
+	array->items[array->num++] = list;
+
+	_notification_list_hash_insert(list);
+
+	return 0;
+}
+
+EXPORT_API notification_list_h notification_list_get_head(notification_list_h list)
+{
 	if (list == NULL) {
 		NOTIFICATION_ERR("INVALID DATA : list == NULL");
 		return NULL;
 	}
 
-	cur_list = list;
+	return list->array->items[list->array->first];
+}
 
-	while (cur_list->next != NULL) {
-		cur_list = cur_list->next;
+EXPORT_API notification_list_h notification_list_get_tail(notification_list_h list)
+{
+	if (list == NULL) {
+		NOTIFICATION_ERR("INVALID DATA : list == NULL");
+		return NULL;
 	}
 
-	return cur_list;
+	return list->array->items[list->array->num - 1];
 }
 
 EXPORT_API notification_list_h notification_list_get_prev(notification_list_h list)
@@ -98,7 +359,11 @@ EXPORT_API notification_list_h notification_list_get_prev(notification_list_h li
 
 	cur_list = list;
 
-	return cur_list->prev;
+	if (cur_list->index <= cur_list->array->first) {
+		return NULL;
+	}
+
+	return cur_list->array->items[cur_list->index - 1];
 }
 
 EXPORT_API notification_list_h notification_list_get_next(notification_list_h list)
@@ -112,7 +377,11 @@ EXPORT_API notification_list_h notification_list_get_next(notification_list_h li
 
 	cur_list = list;
 
-	return cur_list->next;
+	if (cur_list->index + 1 >= cur_list->array->num) {
+		return NULL;
+	}
+
+	return cur_list->array->items[cur_list->index + 1];
 }
 
 EXPORT_API notification_h notification_list_get_data(notification_list_h list)
@@ -129,11 +398,73 @@ EXPORT_API notification_h notification_list_get_data(notification_list_h list)
 	return cur_list->noti;
 }
 
+EXPORT_API int notification_list_get_count(notification_list_h list)
+{
+	if (list == NULL) {
+		return 0;
+	}
+
+	return list->array->num - list->array->first;
+}
+
+EXPORT_API notification_list_h notification_list_get_nth(notification_list_h list,
+							 int nth)
+{
+	if (list == NULL) {
+		NOTIFICATION_ERR("INVALID DATA : list == NULL");
+		return NULL;
+	}
+
+	if (nth < 0 || nth >= list->array->num - list->array->first) {
+		return NULL;
+	}
+
+	return list->array->items[list->array->first + nth];
+}
+
+EXPORT_API notification_list_h notification_list_get_by_priv_id(notification_list_h list,
+								const char *pkgname,
+								int priv_id)
+{
+	notification_list_array_s *array = NULL;
+	notification_list_h cur_list = NULL;
+	notification_h noti = NULL;
+	unsigned int hash = 0;
+
+	if (list == NULL || pkgname == NULL) {
+		NOTIFICATION_ERR("INVALID DATA : list == NULL");
+		return NULL;
+	}
+
+	array = list->array;
+
+	if (array->num_buckets < array->num - array->first) {
+		if (_notification_list_hash_build(array) != 0) {
+			return NULL;
+		}
+	}
+
+	hash = _notification_list_hash(pkgname, priv_id);
+	cur_list = *_notification_list_bucket(array, hash);
+
+	while (cur_list != NULL) {
+		noti = cur_list->noti;
+		if (noti->priv_id == priv_id && noti->caller_pkgname != NULL
+		    && strcmp(noti->caller_pkgname, pkgname) == 0) {
+			return cur_list;
+		}
+
+		cur_list = cur_list->hash_next;
+	}
+
+	return NULL;
+}
+
 EXPORT_API notification_list_h notification_list_append(notification_list_h list,
 							notification_h noti)
 {
+	notification_list_array_s *array = NULL;
 	notification_list_h new_list = NULL;
-	notification_list_h cur_list = NULL;
 
 	if (noti == NULL) {
 		NOTIFICATION_ERR("INVALID DATA : data == NULL");
@@ -141,71 +472,98 @@ EXPORT_API notification_list_h notification_list_append(notification_list_h list
 	}
 
 	if (list != NULL) {
-		cur_list = notification_list_get_tail(list);
-
-		new_list = _notification_list_create();
-		if (new_list == NULL) {
+		array = list->array;
+	} else {
+		array = calloc(1, sizeof(notification_list_array_s));
+		if (array == NULL) {
 			NOTIFICATION_ERR("NO MEMORY");
 			return NULL;
 		}
+	}
 
-		cur_list->next = new_list;
-		new_list->prev = cur_list;
+	new_list = _notification_list_create(array, noti);
+	if (new_list == NULL) {
+		goto err;
+	}
 
-		new_list->noti = noti;
-	} else {
-		cur_list = _notification_list_create();
-		if (cur_list == NULL) {
-			NOTIFICATION_ERR("NO MEMORY");
-			return NULL;
+	if (_notification_list_array_append(array, new_list) != 0) {
+		if (!new_list->in_arena) {
+			free(new_list);
 		}
-
-		new_list = cur_list;
-		new_list->noti = noti;
+		goto err;
 	}
 
 	return new_list;
+
+ err:
+	if (list == NULL) {
+		_notification_list_array_free(array);
+	}
+
+	return NULL;
 }
 
 EXPORT_API notification_list_h notification_list_remove(notification_list_h list,
 							notification_h noti)
 {
+	notification_list_array_s *array = NULL;
 	notification_list_h cur_list = NULL;
-	notification_list_h prev_list = NULL;
-	notification_list_h next_list = NULL;
+	int i = 0;
 
-	cur_list = notification_list_get_head(list);
-	while (cur_list != NULL) {
-		if (cur_list->noti == noti) {
-			//remove
-			prev_list = cur_list->prev;
-			next_list = cur_list->next;
-
-			if (next_list != NULL) {
-				if (prev_list != NULL) {
-					prev_list->next = next_list;
-					next_list->prev = prev_list;
-				} else {
-					next_list->prev = NULL;
-				}
-			} else {
-				if (prev_list != NULL) {
-					prev_list->next = NULL;
-				}
+	if (list == NULL) {
+		return NULL;
+	}
+
+	array = list->array;
+
+	/* Removing item of list given is common, as freeing from head */
+	if (list->noti == noti) {
+		cur_list = list;
+	} else {
+		for (i = array->first; i < array->num; i++) {
+			if (array->items[i]->noti == noti) {
+				cur_list = array->items[i];
+				break;
 			}
+		}
+	}
 
-			free(cur_list);
-			break;
+	if (cur_list == NULL) {
+		return array->items[array->first];
+	}
+
+	_notification_list_hash_remove(cur_list);
+
+	/* Removed notification stays valid until caller frees it, though
+	 * last remove releases arena of list */
+	if (array->arena != NULL && cur_list->noti->arena == array->arena) {
+		notification_detach(cur_list->noti);
+	}
+
+	if (cur_list->index == array->first) {
+		array->first++;
+	} else if (cur_list->index == array->num - 1) {
+		array->num--;
+	} else {
+		memmove(&array->items[cur_list->index],
+			&array->items[cur_list->index + 1],
+			sizeof(notification_list_h) *
+			(array->num - cur_list->index - 1));
+		array->num--;
+
+		for (i = cur_list->index; i < array->num; i++) {
+			array->items[i]->index = i;
 		}
+	}
 
-		cur_list = cur_list->next;
+	if (!cur_list->in_arena) {
+		free(cur_list);
 	}
 
-	if (prev_list != NULL) {
-		return notification_list_get_head(prev_list);
-	} else if (next_list != NULL) {
-		return next_list;
+	if (array->first == array->num) {
+		_notification_list_array_free(array);
+		return NULL;
 	}
 
-	return NULL;
+	return array->items[array->first];
 }
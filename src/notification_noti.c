@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include <vconf.h>
 
@@ -30,149 +31,555 @@
 #include <notification_noti.h>
 #include <notification_debug.h>
 #include <notification_internal.h>
+#include <notification_arena.h>
+
+/* Sequence name of internal group id in noti_id_seq.
+ * Other sequences are named by caller pkgname, which never has '/' */
+#define NOTIFICATION_NOTI_SEQ_INTERNAL_GROUP_ID "/internal_group_id"
+
+/* Text and key of each notification_text_type_e, in the same order */
+#define NOTIFICATION_NOTI_TEXT_COLUMNS \
+	"text_title, text_content, text_content_off, " \
+	"text_group_title, text_group_content, text_group_content_off, " \
+	"key_title, key_content, key_content_off, " \
+	"key_group_title, key_group_content, key_group_content_off, "
+
+#define NOTIFICATION_NOTI_TEXT_PARAMS \
+	"$text_title, $text_content, $text_content_off, " \
+	"$text_group_title, $text_group_content, $text_group_content_off, " \
+	"$key_title, $key_content, $key_content_off, " \
+	"$key_group_title, $key_group_content, $key_group_content_off, "
+
+/* Columns read by _notification_noti_get_item(), keep in the same order */
+#define NOTIFICATION_NOTI_SELECT_ITEM "select " \
+	"type, caller_pkgname, launch_pkgname, image_path, group_id, priv_id, " \
+	NOTIFICATION_NOTI_TEXT_COLUMNS \
+	"b_format_args, num_format_args, " \
+	"text_domain, text_dir, time, insert_time, args, group_args, " \
+	"b_execute_option, b_service_responding, b_service_single_launch, b_service_multi_launch, " \
+	"sound_type, sound_path, vibration_type, vibration_path, " \
+	"flags_for_property, display_applist, progress_size, progress_percentage, " \
+	"rowid " \
+	"from noti_list "
+
+/* Same columns without execute option and services */
+#define NOTIFICATION_NOTI_SELECT_SUMMARY "select " \
+	"type, caller_pkgname, launch_pkgname, image_path, group_id, priv_id, " \
+	NOTIFICATION_NOTI_TEXT_COLUMNS \
+	"b_format_args, num_format_args, " \
+	"text_domain, text_dir, time, insert_time, args, group_args, " \
+	"NULL, NULL, NULL, NULL, " \
+	"sound_type, sound_path, vibration_type, vibration_path, " \
+	"flags_for_property, display_applist, progress_size, progress_percentage, " \
+	"rowid " \
+	"from noti_list "
+
+/* Bind parameter name of each notification_bundle_e column */
+static const char *g_bundle_bind_name[NOTIFICATION_BUNDLE_MAX] = {
+	"$args",
+	"$group_args",
+	"$b_execute_option",
+	"$b_service_responding",
+	"$b_service_single_launch",
+	"$b_service_multi_launch",
+	"$b_text",		/* Not bound, see NOTIFICATION_NOTI_TEXT_COLUMNS */
+	"$b_key",
+	"$b_format_args",
+	"$image_path",
+};
+
+/* Bind parameter name of text and key columns */
+static const char *g_text_bind_name[NOTIFICATION_TEXT_TYPE_MAX] = {
+	"$text_title",
+	"$text_content",
+	"$text_content_off",
+	"$text_group_title",
+	"$text_group_content",
+	"$text_group_content_off",
+};
+
+static const char *g_key_bind_name[NOTIFICATION_TEXT_TYPE_MAX] = {
+	"$key_title",
+	"$key_content",
+	"$key_content_off",
+	"$key_group_title",
+	"$key_group_content",
+	"$key_group_content_off",
+};
+
+static bundle **_notification_noti_get_bundle_ptr(notification_h noti,
+						  notification_bundle_e field)
+{
+	switch (field) {
+	case NOTIFICATION_BUNDLE_ARGS:
+		return &noti->args;
+	case NOTIFICATION_BUNDLE_GROUP_ARGS:
+		return &noti->group_args;
+	case NOTIFICATION_BUNDLE_EXECUTE_OPTION:
+		return &noti->b_execute_option;
+	case NOTIFICATION_BUNDLE_SERVICE_RESPONDING:
+		return &noti->b_service_responding;
+	case NOTIFICATION_BUNDLE_SERVICE_SINGLE_LAUNCH:
+		return &noti->b_service_single_launch;
+	case NOTIFICATION_BUNDLE_SERVICE_MULTI_LAUNCH:
+		return &noti->b_service_multi_launch;
+	default:
+		return NULL;
+	}
+}
 
-static int _notification_noti_bind_query(sqlite3_stmt * stmt, const char *name,
-					 const char *str)
+/* Image path of each image type from bundle of image_path column */
+static void _notification_noti_image_from_bundle(notification_h noti,
+						 bundle * b)
 {
-	int ret = 0;
-	int index = 0;
+	char buf_key[32] = { 0, };
+	const char *val = NULL;
+	int type = 0;
 
-	index = sqlite3_bind_parameter_index(stmt, name);
-	if (index == 0) {
-		NOTIFICATION_ERR("Insert : invalid column name");
-		return NOTIFICATION_ERROR_FROM_DB;
+	if (b == NULL) {
+		return;
 	}
 
-	ret =
-	    sqlite3_bind_text(stmt, index, NOTIFICATION_CHECK_STR(str), -1,
-			      SQLITE_STATIC);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Insert text : %s",
-				 NOTIFICATION_CHECK_STR(str));
-		return NOTIFICATION_ERROR_FROM_DB;
+	for (type = 0; type < NOTIFICATION_IMAGE_TYPE_MAX; type++) {
+		snprintf(buf_key, sizeof(buf_key), "%d", type);
+		val = bundle_get_val(b, buf_key);
+		if (val != NULL) {
+			notification_arena_free(noti->arena,
+						noti->image_path[type]);
+			noti->image_path[type] = strdup(val);
+		}
 	}
+}
 
-	return NOTIFICATION_ERROR_NONE;
+/* Bundle of image_path column, NULL if no image path is set */
+static bundle *_notification_noti_image_to_bundle(notification_h noti)
+{
+	bundle *b = NULL;
+	char buf_key[32] = { 0, };
+	int type = 0;
+
+	for (type = 0; type < NOTIFICATION_IMAGE_TYPE_MAX; type++) {
+		if (noti->image_path[type] == NULL) {
+			continue;
+		}
+
+		if (b == NULL) {
+			b = bundle_create();
+			if (b == NULL) {
+				return NULL;
+			}
+		}
+
+		snprintf(buf_key, sizeof(buf_key), "%d", type);
+		bundle_add(b, buf_key, noti->image_path[type]);
+	}
+
+	return b;
 }
 
-static int _notification_noti_check_priv_id(notification_h noti, sqlite3 * db)
+void notification_noti_free_format_args(notification_h noti,
+				       notification_text_type_e type)
 {
-	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
-	int ret = NOTIFICATION_ERROR_NONE, result = 0;
+	notification_format_arg_s *args = noti->format_args[type];
+	int i = 0;
+
+	if (args != NULL) {
+		for (i = 0; i < noti->num_format_args[type]; i++) {
+			if (args[i].type == NOTIFICATION_VARIABLE_TYPE_STRING) {
+				notification_arena_free(noti->arena,
+							args[i].value.s);
+			}
+		}
+		notification_arena_free(noti->arena, args);
+	}
 
-	/* Make query to check priv_id exist */
-	snprintf(query, sizeof(query),
-		 "select count(*) from noti_list where caller_pkgname = '%s' and priv_id = %d",
-		 noti->caller_pkgname, noti->priv_id);
+	noti->format_args[type] = NULL;
+	noti->num_format_args[type] = 0;
+}
 
-	ret = sqlite3_prepare(db, query, strlen(query), &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Get count DB err(%d) : %s", ret,
-				 sqlite3_errmsg(db));
-		return NOTIFICATION_ERROR_FROM_DB;
+/* Format args from bundle of older version. "num<text type>" is number
+ * of args, "<text type>type<n>" and "<text type>value<n>" are type and
+ * value of each arg as string */
+static void _notification_noti_format_args_from_bundle(notification_h noti,
+						       bundle * b)
+{
+	notification_format_arg_s *args = NULL;
+	char buf_key[32] = { 0, };
+	const char *val = NULL;
+	int type = 0;
+	int num = 0;
+	int i = 0;
+
+	if (b == NULL) {
+		return;
 	}
 
-	ret = sqlite3_step(stmt);
-	if (ret == SQLITE_ROW) {
-		result = sqlite3_column_int(stmt, 0);
-	} else {
-		result = 0;
+	for (type = 0; type < NOTIFICATION_TEXT_TYPE_MAX; type++) {
+		snprintf(buf_key, sizeof(buf_key), "num%d", type);
+		val = bundle_get_val(b, buf_key);
+		num = val != NULL ? atoi(val) : 0;
+		if (num <= 0) {
+			continue;
+		}
+
+		args = calloc(num, sizeof(notification_format_arg_s));
+		if (args == NULL) {
+			return;
+		}
+
+		for (i = 0; i < num; i++) {
+			snprintf(buf_key, sizeof(buf_key), "%dtype%d", type, i);
+			val = bundle_get_val(b, buf_key);
+			if (val == NULL) {
+				break;
+			}
+			args[i].type = atoi(val);
+
+			snprintf(buf_key, sizeof(buf_key), "%dvalue%d", type, i);
+			val = bundle_get_val(b, buf_key);
+			if (val == NULL) {
+				break;
+			}
+
+			if (args[i].type == NOTIFICATION_VARIABLE_TYPE_INT
+			    || args[i].type == NOTIFICATION_VARIABLE_TYPE_COUNT) {
+				args[i].value.i = atoi(val);
+			} else if (args[i].type ==
+				   NOTIFICATION_VARIABLE_TYPE_DOUBLE) {
+				args[i].value.d = atof(val);
+			} else if (args[i].type ==
+				   NOTIFICATION_VARIABLE_TYPE_STRING) {
+				args[i].value.s = strdup(val);
+			} else {
+				break;
+			}
+		}
+
+		notification_noti_free_format_args(noti, type);
+		noti->format_args[type] = args;
+		noti->num_format_args[type] = i;
 	}
+}
 
-	sqlite3_finalize(stmt);
+/* Format args from blob of _notification_noti_format_args_encode(),
+ * reading stops at broken data */
+static void _notification_noti_format_args_decode(notification_h noti,
+						  const char *blob, int len)
+{
+	notification_format_arg_s *args = NULL;
+	notification_format_arg_s *arg = NULL;
+	int pos = NOTIFICATION_FORMAT_ARGS_MAGIC_LEN;
+	int type = 0;
+	int num = 0;
+	int str_len = 0;
+	int i = 0;
+
+	while (pos + 1 + (int)sizeof(int) <= len) {
+		type = (unsigned char)blob[pos++];
+		memcpy(&num, blob + pos, sizeof(int));
+		pos += sizeof(int);
+		if (type >= NOTIFICATION_TEXT_TYPE_MAX || num <= 0
+		    || num > len - pos) {
+			return;
+		}
 
-	/* If result > 0, there is priv_id in DB */
-	if (result > 0) {
-		return NOTIFICATION_ERROR_ALREADY_EXIST_ID;
+		args = calloc(num, sizeof(notification_format_arg_s));
+		if (args == NULL) {
+			return;
+		}
+
+		for (i = 0; i < num && pos < len; i++) {
+			arg = &args[i];
+			arg->type = (unsigned char)blob[pos++];
+
+			if (arg->type == NOTIFICATION_VARIABLE_TYPE_DOUBLE) {
+				if (pos + (int)sizeof(double) > len) {
+					break;
+				}
+				memcpy(&arg->value.d, blob + pos, sizeof(double));
+				pos += sizeof(double);
+			} else if (arg->type == NOTIFICATION_VARIABLE_TYPE_STRING) {
+				if (pos + (int)sizeof(int) > len) {
+					break;
+				}
+				memcpy(&str_len, blob + pos, sizeof(int));
+				pos += sizeof(int);
+				if (str_len < 0 || str_len > len - pos) {
+					break;
+				}
+				arg->value.s = strndup(blob + pos, str_len);
+				pos += str_len;
+			} else if (arg->type == NOTIFICATION_VARIABLE_TYPE_INT
+				   || arg->type ==
+				   NOTIFICATION_VARIABLE_TYPE_COUNT) {
+				if (pos + (int)sizeof(int) > len) {
+					break;
+				}
+				memcpy(&arg->value.i, blob + pos, sizeof(int));
+				pos += sizeof(int);
+			} else {
+				break;
+			}
+		}
+
+		notification_noti_free_format_args(noti, type);
+		noti->format_args[type] = args;
+		noti->num_format_args[type] = i;
+
+		if (i < num) {
+			return;
+		}
 	}
+}
 
-	return NOTIFICATION_ERROR_NONE;
+/* Blob of b_format_args column, NULL if no format args is set.
+ * Caller frees it */
+static char *_notification_noti_format_args_encode(notification_h noti,
+						   int *len)
+{
+	notification_format_arg_s *arg = NULL;
+	char *blob = NULL;
+	int size = NOTIFICATION_FORMAT_ARGS_MAGIC_LEN;
+	int pos = 0;
+	int str_len = 0;
+	int type = 0;
+	int i = 0;
+
+	for (type = 0; type < NOTIFICATION_TEXT_TYPE_MAX; type++) {
+		if (noti->num_format_args[type] <= 0) {
+			continue;
+		}
+
+		size += 1 + sizeof(int);
+		for (i = 0; i < noti->num_format_args[type]; i++) {
+			arg = &noti->format_args[type][i];
+			if (arg->type == NOTIFICATION_VARIABLE_TYPE_DOUBLE) {
+				size += 1 + sizeof(double);
+			} else if (arg->type == NOTIFICATION_VARIABLE_TYPE_STRING
+				   && arg->value.s != NULL) {
+				size += 1 + sizeof(int) + strlen(arg->value.s);
+			} else {
+				size += 1 + sizeof(int);
+			}
+		}
+	}
+
+	if (size == NOTIFICATION_FORMAT_ARGS_MAGIC_LEN) {
+		return NULL;
+	}
+
+	blob = malloc(size);
+	if (blob == NULL) {
+		return NULL;
+	}
+
+	memcpy(blob, NOTIFICATION_FORMAT_ARGS_MAGIC,
+	       NOTIFICATION_FORMAT_ARGS_MAGIC_LEN);
+	pos = NOTIFICATION_FORMAT_ARGS_MAGIC_LEN;
+
+	for (type = 0; type < NOTIFICATION_TEXT_TYPE_MAX; type++) {
+		if (noti->num_format_args[type] <= 0) {
+			continue;
+		}
+
+		blob[pos++] = type;
+		memcpy(blob + pos, &noti->num_format_args[type], sizeof(int));
+		pos += sizeof(int);
+
+		for (i = 0; i < noti->num_format_args[type]; i++) {
+			arg = &noti->format_args[type][i];
+			blob[pos++] = arg->type;
+
+			if (arg->type == NOTIFICATION_VARIABLE_TYPE_DOUBLE) {
+				memcpy(blob + pos, &arg->value.d, sizeof(double));
+				pos += sizeof(double);
+			} else if (arg->type == NOTIFICATION_VARIABLE_TYPE_STRING) {
+				str_len = arg->value.s != NULL ?
+				    strlen(arg->value.s) : 0;
+				memcpy(blob + pos, &str_len, sizeof(int));
+				pos += sizeof(int);
+				if (str_len > 0) {
+					memcpy(blob + pos, arg->value.s,
+					       str_len);
+					pos += str_len;
+				}
+			} else {
+				memcpy(blob + pos, &arg->value.i, sizeof(int));
+				pos += sizeof(int);
+			}
+		}
+	}
+
+	*len = size;
+
+	return blob;
 }
 
-static int _notification_noti_get_priv_id(notification_h noti, sqlite3 * db)
+/* Keep binary bundle column to decode on first use, in arena if it is
+ * not NULL. Text column of not upgraded DB is decoded at once. */
+static void _notification_noti_column_bundle(notification_h noti,
+					     sqlite3_stmt * stmt, int col,
+					     notification_bundle_e field,
+					     notification_arena_s * arena)
+{
+	const void *blob = NULL;
+	bundle *b = NULL;
+	int len = 0;
+
+	if (sqlite3_column_type(stmt, col) == SQLITE_BLOB && arena != NULL) {
+		blob = sqlite3_column_blob(stmt, col);
+		len = sqlite3_column_bytes(stmt, col);
+		if (blob != NULL && len > 0) {
+			noti->raw_bundle[field] =
+			    notification_arena_memdup(arena, blob, len);
+			if (noti->raw_bundle[field] != NULL) {
+				noti->raw_bundle_len[field] = len;
+			}
+		}
+	} else if (sqlite3_column_type(stmt, col) == SQLITE_BLOB) {
+		noti->raw_bundle[field] =
+		    notification_db_column_blob(stmt, col,
+						&noti->raw_bundle_len[field]);
+	} else if (field == NOTIFICATION_BUNDLE_IMAGE_PATH
+		   || field == NOTIFICATION_BUNDLE_FORMAT_ARGS) {
+		b = notification_db_column_bundle(stmt, col);
+		if (b != NULL && field == NOTIFICATION_BUNDLE_IMAGE_PATH) {
+			_notification_noti_image_from_bundle(noti, b);
+		} else if (b != NULL) {
+			_notification_noti_format_args_from_bundle(noti, b);
+		}
+		if (b != NULL) {
+			bundle_free(b);
+		}
+	} else {
+		*_notification_noti_get_bundle_ptr(noti, field) =
+		    notification_db_column_bundle(stmt, col);
+	}
+}
+
+/* Read execute option and services left out by summary fetch */
+static void _notification_noti_load_service(notification_h noti)
 {
+	sqlite3 *db = NULL;
 	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
-	int ret = NOTIFICATION_ERROR_NONE, result = 0;
+	int field = 0;
+	int col = 0;
 
-	/* Make query to get max priv_id */
-	snprintf(query, sizeof(query),
-		 "select max(priv_id) from noti_list where caller_pkgname = '%s'",
-		 noti->caller_pkgname);
+	if (noti->summary == 0) {
+		return;
+	}
 
-	ret = sqlite3_prepare(db, query, strlen(query), &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Get count DB err(%d) : %s", ret,
-				 sqlite3_errmsg(db));
-		return NOTIFICATION_ERROR_FROM_DB;
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return;
 	}
 
-	ret = sqlite3_step(stmt);
-	if (ret == SQLITE_ROW) {
-		result = sqlite3_column_int(stmt, 0);
-	} else {
-		result = 0;
+	stmt = notification_db_prepare(db, "select "
+				       "b_execute_option, b_service_responding, "
+				       "b_service_single_launch, b_service_multi_launch "
+				       "from noti_list "
+				       "where caller_pkgname = $caller_pkgname and priv_id = $priv_id");
+	if (stmt == NULL) {
+		goto err;
 	}
 
-	sqlite3_finalize(stmt);
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      noti->caller_pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$priv_id",
+					noti->priv_id) != NOTIFICATION_ERROR_NONE) {
+		goto err;
+	}
 
-	if (result < 0) {
-		return NOTIFICATION_ERROR_FROM_DB;
+	if (sqlite3_step(stmt) == SQLITE_ROW) {
+		for (field = NOTIFICATION_BUNDLE_EXECUTE_OPTION;
+		     field <= NOTIFICATION_BUNDLE_SERVICE_MULTI_LAUNCH;
+		     field++) {
+			/* Arena is not shared with reading thread */
+			_notification_noti_column_bundle(noti, stmt, col++,
+							 field, NULL);
+		}
 	}
 
-	/* Increase result(max priv_id value) for next priv_id */
-	noti->priv_id = result + 1;
+	/* Row is gone if not found, nothing to load any more */
+	noti->summary = 0;
 
-	return NOTIFICATION_ERROR_NONE;
+err:
+	if (stmt) {
+		notification_db_finalize(stmt);
+	}
+
+	/* Release DB */
+	notification_db_release(&db);
 }
 
-static int _notification_noti_get_internal_group_id_by_priv_id(const char *pkgname,
-							       int priv_id,
-							       sqlite3 * db)
+void notification_noti_decode_bundle(notification_h noti,
+				     notification_bundle_e field)
 {
-	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
-	int ret = NOTIFICATION_ERROR_NONE, result = 0;
+	bundle **b = NULL;
+	bundle *image_path = NULL;
+	bundle *format_args = NULL;
+	char *raw = NULL;
+	int len = 0;
 
-	snprintf(query, sizeof(query),
-		 "select internal_group_id from noti_list where caller_pkgname = '%s' and priv_id = %d",
-		 pkgname, priv_id);
+	if (field >= NOTIFICATION_BUNDLE_EXECUTE_OPTION
+	    && field <= NOTIFICATION_BUNDLE_SERVICE_MULTI_LAUNCH) {
+		_notification_noti_load_service(noti);
+	}
 
-	ret = sqlite3_prepare(db, query, strlen(query), &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Get count DB err(%d) : %s", ret,
-				 sqlite3_errmsg(db));
-		return NOTIFICATION_ERROR_FROM_DB;
+	raw = noti->raw_bundle[field];
+	len = noti->raw_bundle_len[field];
+	if (raw == NULL) {
+		return;
 	}
 
-	ret = sqlite3_step(stmt);
-	if (ret == SQLITE_ROW) {
-		result = sqlite3_column_int(stmt, 0);
+	if (field == NOTIFICATION_BUNDLE_IMAGE_PATH) {
+		image_path = bundle_decode_raw((bundle_raw *) raw, len);
+		if (image_path != NULL) {
+			_notification_noti_image_from_bundle(noti, image_path);
+			bundle_free(image_path);
+		}
+	} else if (field == NOTIFICATION_BUNDLE_FORMAT_ARGS
+		   && len >= NOTIFICATION_FORMAT_ARGS_MAGIC_LEN
+		   && memcmp(raw, NOTIFICATION_FORMAT_ARGS_MAGIC,
+			     NOTIFICATION_FORMAT_ARGS_MAGIC_LEN) == 0) {
+		_notification_noti_format_args_decode(noti, raw, len);
+	} else if (field == NOTIFICATION_BUNDLE_FORMAT_ARGS) {
+		/* Written by older version */
+		format_args = bundle_decode_raw((bundle_raw *) raw, len);
+		if (format_args != NULL) {
+			_notification_noti_format_args_from_bundle(noti,
+								   format_args);
+			bundle_free(format_args);
+		}
 	} else {
-		result = 0;
+		b = _notification_noti_get_bundle_ptr(noti, field);
+		*b = bundle_decode_raw((bundle_raw *) raw, len);
 	}
 
-	sqlite3_finalize(stmt);
-
-	return result;
+	notification_arena_free(noti->arena, raw);
+	noti->raw_bundle[field] = NULL;
+	noti->raw_bundle_len[field] = 0;
 }
 
-static int _notification_noti_get_max_internal_group_id(notification_h noti,
-							sqlite3 * db)
+static int _notification_noti_check_priv_id(notification_h noti, sqlite3 * db)
 {
 	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
 	int ret = NOTIFICATION_ERROR_NONE, result = 0;
 
-	/* Get max internal group id */
-	snprintf(query, sizeof(query),
-		 "select max(internal_group_id) from noti_list");
+	/* Make query to check priv_id exist */
+	stmt = notification_db_prepare(db,
+				       "select count(*) from noti_list "
+				       "where caller_pkgname = $caller_pkgname and priv_id = $priv_id");
+	if (stmt == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
-	ret = sqlite3_prepare(db, query, strlen(query), &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Get count DB err(%d) : %s", ret,
-				 sqlite3_errmsg(db));
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      noti->caller_pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$priv_id",
+					noti->priv_id) != NOTIFICATION_ERROR_NONE) {
+		notification_db_finalize(stmt);
 		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
@@ -183,443 +590,570 @@ static int _notification_noti_get_max_internal_group_id(notification_h noti,
 		result = 0;
 	}
 
-	sqlite3_finalize(stmt);
+	notification_db_finalize(stmt);
 
-	return result;
+	/* If result > 0, there is priv_id in DB */
+	if (result > 0) {
+		return NOTIFICATION_ERROR_ALREADY_EXIST_ID;
+	}
+
+	return NOTIFICATION_ERROR_NONE;
 }
 
-static int _notification_noti_get_internal_group_id(notification_h noti,
-						    sqlite3 * db)
+/* Get last ID given out for name, seeding it from noti_list the first time */
+static int _notification_noti_seq_get(sqlite3 * db, const char *name,
+				      const char *seed_query,
+				      const char *pkgname, int *seq)
 {
 	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
-	int ret = NOTIFICATION_ERROR_NONE, result = 0;
-	const char *ret_title = NULL;
-	char buf_key[32] = { 0, };
+	int ret = NOTIFICATION_ERROR_NONE;
 
-	if (noti->group_id == NOTIFICATION_GROUP_ID_NONE) {
-		/* If Group ID is NONE Get max internal group ID */
-		result = _notification_noti_get_max_internal_group_id(noti, db);
-		if (result < 0) {
-			return NOTIFICATION_ERROR_FROM_DB;
-		}
+	stmt = notification_db_prepare(db,
+				       "select seq from noti_id_seq where name = $name");
+	if (stmt == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
-		/* Internal Group ID is max internal group ID + 1 */
-		noti->internal_group_id = result + 1;
+	if (notification_db_bind_text(stmt, "$name",
+				      name) != NOTIFICATION_ERROR_NONE) {
+		notification_db_finalize(stmt);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
+	ret = sqlite3_step(stmt);
+	if (ret == SQLITE_ROW) {
+		*seq = sqlite3_column_int(stmt, 0);
+		notification_db_finalize(stmt);
 		return NOTIFICATION_ERROR_NONE;
-	} else if (noti->group_id == NOTIFICATION_GROUP_ID_DEFAULT) {
-		/* If Group ID is DEFAULT, Get internal group id if it exist */
-		if (noti->b_key != NULL) {
-			snprintf(buf_key, sizeof(buf_key), "%d",
-				 NOTIFICATION_TEXT_TYPE_TITLE);
-
-			ret_title = bundle_get_val(noti->b_key, buf_key);
-		}
-
-		if (ret_title == NULL && noti->b_text != NULL) {
-			snprintf(buf_key, sizeof(buf_key), "%d",
-				 NOTIFICATION_TEXT_TYPE_TITLE);
-
-			ret_title = bundle_get_val(noti->b_text, buf_key);
-		}
+	}
 
-		if (ret_title == NULL) {
-			ret_title = noti->caller_pkgname;
-		}
+	notification_db_finalize(stmt);
 
-		snprintf(query, sizeof(query),
-			 "select internal_group_id from noti_list where title_key = $title_key and group_id = %d",
-			 NOTIFICATION_GROUP_ID_DEFAULT);
-	} else {
-		/* If Group ID is > DEFAULT, Get internal group id if it exit */
-		snprintf(query, sizeof(query),
-			 "select internal_group_id from noti_list where caller_pkgname = '%s' and group_id = %d",
-			 NOTIFICATION_CHECK_STR(noti->caller_pkgname),
-			 noti->group_id);
+	if (ret != SQLITE_DONE) {
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
-	ret = sqlite3_prepare_v2(db, query, -1, &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Select Query : %s", query);
-		NOTIFICATION_ERR("Select DB error(%d) : %s", ret,
-				 sqlite3_errmsg(db));
-		if (stmt) {
-			sqlite3_finalize(stmt);
-		}
+	/* No sequence yet, start from IDs already in noti_list */
+	stmt = notification_db_prepare(db, seed_query);
+	if (stmt == NULL) {
 		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
-	/* Bind query */
-	if (ret_title != NULL) {
-		ret =
-		    _notification_noti_bind_query(stmt, "$title_key",
-						  NOTIFICATION_CHECK_STR
-						  (ret_title));
-		if (ret != NOTIFICATION_ERROR_NONE) {
-			NOTIFICATION_ERR("Bind error : %s", sqlite3_errmsg(db));
-			if (stmt) {
-				sqlite3_finalize(stmt);
-			}
-			return ret;
-		}
+	if (pkgname != NULL
+	    && notification_db_bind_text(stmt, "$caller_pkgname",
+					 pkgname) != NOTIFICATION_ERROR_NONE) {
+		notification_db_finalize(stmt);
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
 	ret = sqlite3_step(stmt);
 	if (ret == SQLITE_ROW) {
-		result = sqlite3_column_int(stmt, 0);
+		*seq = sqlite3_column_int(stmt, 0);
 	} else {
-		/* If there is not internal_group_id, create new one */
-		result = _notification_noti_get_max_internal_group_id(noti, db);
-		result++;
+		*seq = 0;
 	}
 
-	sqlite3_finalize(stmt);
-
-	noti->internal_group_id = result;
+	notification_db_finalize(stmt);
 
 	return NOTIFICATION_ERROR_NONE;
 }
 
-static int _notification_noti_make_query(notification_h noti, char *query,
-					 int query_size)
+static int _notification_noti_seq_set(sqlite3 * db, const char *name, int seq)
 {
-	char *args = NULL;
-	char *group_args = NULL;
-	char *b_image_path = NULL;
-	char *b_execute_option = NULL;
-	char *b_service_responding = NULL;
-	char *b_service_single_launch = NULL;
-	char *b_service_multi_launch = NULL;
-	char *b_text = NULL;
-	char *b_key = NULL;
-	char *b_format_args = NULL;
-	int flag_simmode = 0;
-
-	/* Decode bundle to insert DB */
-	if (noti->args) {
-		bundle_encode(noti->args, (bundle_raw **) & args, NULL);
-	}
-	if (noti->group_args) {
-		bundle_encode(noti->group_args, (bundle_raw **) & group_args,
-			      NULL);
-	}
+	sqlite3_stmt *stmt = NULL;
+	int ret = NOTIFICATION_ERROR_NONE;
 
-	if (noti->b_execute_option) {
-		bundle_encode(noti->b_execute_option,
-			      (bundle_raw **) & b_execute_option, NULL);
-	}
-	if (noti->b_service_responding) {
-		bundle_encode(noti->b_service_responding,
-			      (bundle_raw **) & b_service_responding, NULL);
-	}
-	if (noti->b_service_single_launch) {
-		bundle_encode(noti->b_service_single_launch,
-			      (bundle_raw **) & b_service_single_launch, NULL);
-	}
-	if (noti->b_service_multi_launch) {
-		bundle_encode(noti->b_service_multi_launch,
-			      (bundle_raw **) & b_service_multi_launch, NULL);
+	stmt = notification_db_prepare(db,
+				       "insert or replace into noti_id_seq (name, seq) "
+				       "values ($name, $seq)");
+	if (stmt == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
-	if (noti->b_text) {
-		bundle_encode(noti->b_text, (bundle_raw **) & b_text, NULL);
-	}
-	if (noti->b_key) {
-		bundle_encode(noti->b_key, (bundle_raw **) & b_key, NULL);
-	}
-	if (noti->b_format_args) {
-		bundle_encode(noti->b_format_args,
-			      (bundle_raw **) & b_format_args, NULL);
+	if (notification_db_bind_text(stmt, "$name",
+				      name) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$seq",
+					seq) != NOTIFICATION_ERROR_NONE) {
+		notification_db_finalize(stmt);
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
-	if (noti->b_image_path) {
-		bundle_encode(noti->b_image_path,
-			      (bundle_raw **) & b_image_path, NULL);
-	}
+	ret = sqlite3_step(stmt);
 
-	/* Check only simmode property is enable */
-	if (noti->flags_for_property & NOTIFICATION_PROP_DISPLAY_ONLY_SIMMODE) {
-		flag_simmode = 1;
-	}
+	notification_db_finalize(stmt);
 
-	/* Make query */
-	snprintf(query, query_size, "insert into noti_list ("
-		 "type, "
-		 "caller_pkgname, launch_pkgname, "
-		 "image_path, "
-		 "group_id, internal_group_id, priv_id, "
-		 "title_key, "
-		 "b_text, b_key, b_format_args, num_format_args, "
-		 "text_domain, text_dir, "
-		 "time, insert_time, "
-		 "args, group_args, "
-		 "b_execute_option, "
-		 "b_service_responding, b_service_single_launch, b_service_multi_launch, "
-		 "sound_type, sound_path, vibration_type, vibration_path, "
-		 "flags_for_property, flag_simmode, display_applist, "
-		 "progress_size, progress_percentage) values ("
-		 "%d, "
-		 "'%s', '%s', "
-		 "'%s', "
-		 "%d, %d, %d, "
-		 "$title_key, "
-		 "'%s', '%s', '%s', %d, "
-		 "'%s', '%s', "
-		 "%d, %d, "
-		 "'%s', '%s', "
-		 "'%s', "
-		 "'%s', '%s', '%s', "
-		 "%d, '%s', %d, '%s', "
-		 "%d, %d, %d, "
-		 "%f, %f)",
-		 noti->type,
-		 NOTIFICATION_CHECK_STR(noti->caller_pkgname),
-		 NOTIFICATION_CHECK_STR(noti->launch_pkgname),
-		 NOTIFICATION_CHECK_STR(b_image_path), noti->group_id,
-		 noti->internal_group_id, noti->priv_id,
-		 NOTIFICATION_CHECK_STR(b_text), NOTIFICATION_CHECK_STR(b_key),
-		 NOTIFICATION_CHECK_STR(b_format_args), noti->num_format_args,
-		 NOTIFICATION_CHECK_STR(noti->domain),
-		 NOTIFICATION_CHECK_STR(noti->dir), (int)noti->time,
-		 (int)noti->insert_time, NOTIFICATION_CHECK_STR(args),
-		 NOTIFICATION_CHECK_STR(group_args),
-		 NOTIFICATION_CHECK_STR(b_execute_option),
-		 NOTIFICATION_CHECK_STR(b_service_responding),
-		 NOTIFICATION_CHECK_STR(b_service_single_launch),
-		 NOTIFICATION_CHECK_STR(b_service_multi_launch),
-		 noti->sound_type, NOTIFICATION_CHECK_STR(noti->sound_path),
-		 noti->vibration_type,
-		 NOTIFICATION_CHECK_STR(noti->vibration_path),
-		 noti->flags_for_property, flag_simmode, noti->display_applist,
-		 noti->progress_size, noti->progress_percentage);
-
-	/* Free decoded data */
-	if (args) {
-		free(args);
-	}
-	if (group_args) {
-		free(group_args);
-	}
-
-	if (b_execute_option) {
-		free(b_execute_option);
-	}
-	if (b_service_responding) {
-		free(b_service_responding);
-	}
-	if (b_service_single_launch) {
-		free(b_service_single_launch);
-	}
-	if (b_service_multi_launch) {
-		free(b_service_multi_launch);
-	}
-
-	if (b_text) {
-		free(b_text);
-	}
-	if (b_key) {
-		free(b_key);
-	}
-	if (b_format_args) {
-		free(b_format_args);
-	}
-
-	if (b_image_path) {
-		free(b_image_path);
+	if (ret != SQLITE_DONE) {
+		NOTIFICATION_ERR("Set sequence DB error(%d) : %s", ret,
+				 sqlite3_errmsg(db));
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
 	return NOTIFICATION_ERROR_NONE;
 }
 
+static int _notification_noti_get_priv_seq(notification_h noti, sqlite3 * db,
+					   int *seq)
+{
+	/* priv_id sequence is kept per caller package, name is pkgname */
+	return _notification_noti_seq_get(db, noti->caller_pkgname,
+					  "select max(priv_id) from noti_list "
+					  "where caller_pkgname = $caller_pkgname",
+					  noti->caller_pkgname, seq);
+}
 
-static int _notification_noti_make_update_query(notification_h noti, char *query,
-					 int query_size)
+static int _notification_noti_get_priv_id(notification_h noti, sqlite3 * db)
 {
-	char *args = NULL;
-	char *group_args = NULL;
-	char *b_image_path = NULL;
-	char *b_execute_option = NULL;
-	char *b_service_responding = NULL;
-	char *b_service_single_launch = NULL;
-	char *b_service_multi_launch = NULL;
-	char *b_text = NULL;
-	char *b_key = NULL;
-	char *b_format_args = NULL;
-	int flag_simmode = 0;
+	int ret = NOTIFICATION_ERROR_NONE, result = 0;
+	int old_priv_id = noti->priv_id;
 
-	/* Decode bundle to update DB */
-	if (noti->args) {
-		bundle_encode(noti->args, (bundle_raw **) & args, NULL);
-	}
-	if (noti->group_args) {
-		bundle_encode(noti->group_args, (bundle_raw **) & group_args,
-			      NULL);
+	/* Get last priv_id given to this package */
+	ret = _notification_noti_get_priv_seq(noti, db, &result);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
 	}
 
-	if (noti->b_execute_option) {
-		bundle_encode(noti->b_execute_option,
-			      (bundle_raw **) & b_execute_option, NULL);
-	}
-	if (noti->b_service_responding) {
-		bundle_encode(noti->b_service_responding,
-			      (bundle_raw **) & b_service_responding, NULL);
-	}
-	if (noti->b_service_single_launch) {
-		bundle_encode(noti->b_service_single_launch,
-			      (bundle_raw **) & b_service_single_launch, NULL);
-	}
-	if (noti->b_service_multi_launch) {
-		bundle_encode(noti->b_service_multi_launch,
-			      (bundle_raw **) & b_service_multi_launch, NULL);
+	if (result < 0) {
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
-	if (noti->b_text) {
-		bundle_encode(noti->b_text, (bundle_raw **) & b_text, NULL);
-	}
-	if (noti->b_key) {
-		bundle_encode(noti->b_key, (bundle_raw **) & b_key, NULL);
-	}
-	if (noti->b_format_args) {
-		bundle_encode(noti->b_format_args,
-			      (bundle_raw **) & b_format_args, NULL);
-	}
+	/* Increase result(last priv_id value) for next priv_id */
+	noti->priv_id = result + 1;
+	notification_list_rehash(noti, noti->caller_pkgname, old_priv_id);
 
-	if (noti->b_image_path) {
-		bundle_encode(noti->b_image_path,
-			      (bundle_raw **) & b_image_path, NULL);
-	}
+	return _notification_noti_seq_set(db, noti->caller_pkgname,
+					  noti->priv_id);
+}
 
-	/* Check only simmode property is enable */
-	if (noti->flags_for_property & NOTIFICATION_PROP_DISPLAY_ONLY_SIMMODE) {
-		flag_simmode = 1;
+static int _notification_noti_use_priv_id(notification_h noti, sqlite3 * db)
+{
+	int ret = NOTIFICATION_ERROR_NONE, result = 0;
+
+	/* Given priv_id must not be handed out again */
+	ret = _notification_noti_get_priv_seq(noti, db, &result);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
 	}
 
-	/* Make query */
-	snprintf(query, query_size, "update noti_list set "
-		 "type = %d, "
-		 "launch_pkgname = '%s', "
-		 "image_path = '%s', "
-		 "b_text = '%s', b_key = '%s', "
-		 "b_format_args = '%s', num_format_args = %d, "
-		 "text_domain = '%s', text_dir = '%s', "
-		 "time = %d, insert_time = %d, "
-		 "args = '%s', group_args = '%s', "
-		 "b_execute_option = '%s', "
-		 "b_service_responding = '%s', "
-		 "b_service_single_launch = '%s', "
-		 "b_service_multi_launch = '%s', "
-		 "sound_type = %d, sound_path = '%s', "
-		 "vibration_type = %d, vibration_path = '%s', "
-		 "flags_for_property = %d, flag_simmode = %d, "
-		 "display_applist = %d, "
-		 "progress_size = %f, progress_percentage = %f "
-		 "where priv_id = %d ",
-		 noti->type,
-		 NOTIFICATION_CHECK_STR(noti->launch_pkgname),
-		 NOTIFICATION_CHECK_STR(b_image_path),
-		 NOTIFICATION_CHECK_STR(b_text), NOTIFICATION_CHECK_STR(b_key),
-		 NOTIFICATION_CHECK_STR(b_format_args), noti->num_format_args,
-		 NOTIFICATION_CHECK_STR(noti->domain),
-		 NOTIFICATION_CHECK_STR(noti->dir),
-		 (int)noti->time, (int)noti->insert_time,
-		 NOTIFICATION_CHECK_STR(args), NOTIFICATION_CHECK_STR(group_args),
-		 NOTIFICATION_CHECK_STR(b_execute_option),
-		 NOTIFICATION_CHECK_STR(b_service_responding),
-		 NOTIFICATION_CHECK_STR(b_service_single_launch),
-		 NOTIFICATION_CHECK_STR(b_service_multi_launch),
-		 noti->sound_type, NOTIFICATION_CHECK_STR(noti->sound_path),
-		 noti->vibration_type,
-		 NOTIFICATION_CHECK_STR(noti->vibration_path),
-		 noti->flags_for_property, flag_simmode, noti->display_applist,
-		 noti->progress_size, noti->progress_percentage,
-		 noti->priv_id);
-
-	/* Free decoded data */
-	if (args) {
-		free(args);
-	}
-	if (group_args) {
-		free(group_args);
-	}
-
-	if (b_execute_option) {
-		free(b_execute_option);
-	}
-	if (b_service_responding) {
-		free(b_service_responding);
-	}
-	if (b_service_single_launch) {
-		free(b_service_single_launch);
-	}
-	if (b_service_multi_launch) {
-		free(b_service_multi_launch);
-	}
-
-	if (b_text) {
-		free(b_text);
-	}
-	if (b_key) {
-		free(b_key);
-	}
-	if (b_format_args) {
-		free(b_format_args);
-	}
-
-	if (b_image_path) {
-		free(b_image_path);
+	if (noti->priv_id <= result) {
+		return NOTIFICATION_ERROR_NONE;
 	}
 
-	return NOTIFICATION_ERROR_NONE;
+	return _notification_noti_seq_set(db, noti->caller_pkgname,
+					  noti->priv_id);
 }
 
-static notification_h _notification_noti_get_item(sqlite3_stmt * stmt)
-{
-	notification_h noti = NULL;
+static int _notification_noti_get_internal_group_id_by_priv_id(const char *pkgname,
+							       int priv_id,
+							       sqlite3 * db)
+{
+	sqlite3_stmt *stmt = NULL;
+	int ret = NOTIFICATION_ERROR_NONE, result = 0;
+
+	stmt = notification_db_prepare(db,
+				       "select internal_group_id from noti_list "
+				       "where caller_pkgname = $caller_pkgname and priv_id = $priv_id");
+	if (stmt == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$priv_id",
+					priv_id) != NOTIFICATION_ERROR_NONE) {
+		notification_db_finalize(stmt);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	ret = sqlite3_step(stmt);
+	if (ret == SQLITE_ROW) {
+		result = sqlite3_column_int(stmt, 0);
+	} else {
+		result = 0;
+	}
+
+	notification_db_finalize(stmt);
+
+	return result;
+}
+
+static int _notification_noti_get_new_internal_group_id(sqlite3 * db)
+{
+	int ret = NOTIFICATION_ERROR_NONE, result = 0;
+
+	/* Get last internal group id */
+	ret = _notification_noti_seq_get(db, NOTIFICATION_NOTI_SEQ_INTERNAL_GROUP_ID,
+					 "select max(internal_group_id) from noti_list",
+					 NULL, &result);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
+	}
+
+	if (result < 0) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	result++;
+
+	ret = _notification_noti_seq_set(db, NOTIFICATION_NOTI_SEQ_INTERNAL_GROUP_ID,
+					 result);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
+	}
+
+	return result;
+}
+
+/* Title key of noti_list, key of title or title or caller pkgname */
+static const char *_notification_noti_get_title_key(notification_h noti)
+{
+	const char *title_key = NULL;
+
+	title_key = noti->key[NOTIFICATION_TEXT_TYPE_TITLE];
+
+	if (title_key == NULL) {
+		title_key = noti->text[NOTIFICATION_TEXT_TYPE_TITLE];
+	}
+
+	if (title_key == NULL) {
+		title_key = noti->caller_pkgname;
+	}
+
+	return title_key;
+}
+
+static int _notification_noti_get_internal_group_id(notification_h noti,
+						    sqlite3 * db)
+{
+	sqlite3_stmt *stmt = NULL;
+	int ret = NOTIFICATION_ERROR_NONE, result = 0;
+	const char *ret_title = NULL;
+
+	if (noti->group_id == NOTIFICATION_GROUP_ID_NONE) {
+		/* If Group ID is NONE, Internal Group ID is a new one */
+		result = _notification_noti_get_new_internal_group_id(db);
+		if (result < 0) {
+			return result;
+		}
+
+		noti->internal_group_id = result;
+
+		return NOTIFICATION_ERROR_NONE;
+	} else if (noti->group_id == NOTIFICATION_GROUP_ID_DEFAULT) {
+		/* If Group ID is DEFAULT, Get internal group id if it exist */
+		ret_title = _notification_noti_get_title_key(noti);
+
+		stmt = notification_db_prepare(db,
+					       "select internal_group_id from noti_list "
+					       "where title_key = $title_key and group_id = $group_id");
+		if (stmt == NULL) {
+			return NOTIFICATION_ERROR_FROM_DB;
+		}
+
+		ret = notification_db_bind_text(stmt, "$title_key", ret_title);
+	} else {
+		/* If Group ID is > DEFAULT, Get internal group id if it exit */
+		stmt = notification_db_prepare(db,
+					       "select internal_group_id from noti_list "
+					       "where caller_pkgname = $caller_pkgname and group_id = $group_id");
+		if (stmt == NULL) {
+			return NOTIFICATION_ERROR_FROM_DB;
+		}
+
+		ret = notification_db_bind_text(stmt, "$caller_pkgname",
+						noti->caller_pkgname);
+	}
+
+	/* Bind query */
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		ret = notification_db_bind_int(stmt, "$group_id",
+					       noti->group_id);
+	}
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		NOTIFICATION_ERR("Bind error : %s", sqlite3_errmsg(db));
+		notification_db_finalize(stmt);
+		return ret;
+	}
+
+	ret = sqlite3_step(stmt);
+	if (ret == SQLITE_ROW) {
+		result = sqlite3_column_int(stmt, 0);
+		notification_db_finalize(stmt);
+	} else {
+		notification_db_finalize(stmt);
+
+		/* If there is not internal_group_id, create new one */
+		result = _notification_noti_get_new_internal_group_id(db);
+		if (result < 0) {
+			return result;
+		}
+	}
+
+	noti->internal_group_id = result;
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+static int _notification_noti_bind_text(sqlite3_stmt * stmt, char **slots,
+					const char **bind_name)
+{
+	int type = 0;
+	int ret = NOTIFICATION_ERROR_NONE;
+
+	for (type = 0; type < NOTIFICATION_TEXT_TYPE_MAX; type++) {
+		ret = notification_db_bind_text(stmt, bind_name[type],
+						slots[type]);
+		if (ret != NOTIFICATION_ERROR_NONE) {
+			return ret;
+		}
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+/* Bind columns which are common to insert and update query */
+static int _notification_noti_bind_item(notification_h noti,
+					sqlite3_stmt * stmt)
+{
+	bundle *b = NULL;
+	bundle *image_path = NULL;
+	char *raw = NULL;
+	int len = 0;
+	int num_format_args = 0;
+	int flag_simmode = 0;
+	int field = 0;
+	int type = 0;
+	int ret = NOTIFICATION_ERROR_NONE;
+
+	/* Text and key are written to a column per text type */
+	ret = _notification_noti_bind_text(stmt, noti->text, g_text_bind_name);
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		ret = _notification_noti_bind_text(stmt, noti->key,
+						   g_key_bind_name);
+	}
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
+	}
+
+	/* Encode bundle to binary blob, bundle not decoded yet is
+	 * written back as it was read */
+	for (field = 0; field < NOTIFICATION_BUNDLE_MAX; field++) {
+		if (field == NOTIFICATION_BUNDLE_TEXT
+		    || field == NOTIFICATION_BUNDLE_KEY) {
+			continue;
+		}
+
+		if (field == NOTIFICATION_BUNDLE_FORMAT_ARGS
+		    && noti->raw_bundle[field] == NULL) {
+			/* Typed format args are written as blob of their own */
+			len = 0;
+			raw = _notification_noti_format_args_encode(noti, &len);
+			ret = notification_db_bind_blob(stmt,
+							g_bundle_bind_name[field],
+							raw, len);
+			if (raw) {
+				free(raw);
+			}
+			if (ret != NOTIFICATION_ERROR_NONE) {
+				return ret;
+			}
+			continue;
+		}
+
+		image_path = NULL;
+		if (field == NOTIFICATION_BUNDLE_IMAGE_PATH) {
+			/* Image path decoded to slots is a bundle again */
+			if (noti->raw_bundle[field] == NULL) {
+				image_path = _notification_noti_image_to_bundle(noti);
+			}
+			b = image_path;
+		} else if (field == NOTIFICATION_BUNDLE_FORMAT_ARGS) {
+			b = NULL;
+		} else {
+			b = *_notification_noti_get_bundle_ptr(noti, field);
+		}
+
+		if (b != NULL) {
+			raw = NULL;
+			len = 0;
+			bundle_encode_raw(b, (bundle_raw **) & raw, &len);
+
+			ret = notification_db_bind_blob(stmt,
+							g_bundle_bind_name[field],
+							raw, len);
+			if (raw) {
+				free(raw);
+			}
+		} else {
+			ret = notification_db_bind_blob(stmt,
+							g_bundle_bind_name[field],
+							noti->raw_bundle[field],
+							noti->raw_bundle_len[field]);
+		}
+
+		if (image_path != NULL) {
+			bundle_free(image_path);
+		}
+
+		if (ret != NOTIFICATION_ERROR_NONE) {
+			return ret;
+		}
+	}
+
+	/* Total number of format args, for reference only */
+	for (type = 0; type < NOTIFICATION_TEXT_TYPE_MAX; type++) {
+		num_format_args += noti->num_format_args[type];
+	}
+
+	/* Check only simmode property is enable */
+	if (noti->flags_for_property & NOTIFICATION_PROP_DISPLAY_ONLY_SIMMODE) {
+		flag_simmode = 1;
+	}
+
+	/* Bind values, text is copied by sqlite */
+	if (notification_db_bind_int(stmt, "$type", noti->type)
+	    || notification_db_bind_text(stmt, "$caller_pkgname",
+					 noti->caller_pkgname)
+	    || notification_db_bind_text(stmt, "$launch_pkgname",
+					 noti->launch_pkgname)
+	    || notification_db_bind_int(stmt, "$priv_id", noti->priv_id)
+	    || notification_db_bind_int(stmt, "$num_format_args",
+					num_format_args)
+	    || notification_db_bind_text(stmt, "$text_domain", noti->domain)
+	    || notification_db_bind_text(stmt, "$text_dir", noti->dir)
+	    || notification_db_bind_int(stmt, "$time", (int)noti->time)
+	    || notification_db_bind_int(stmt, "$insert_time",
+					(int)noti->insert_time)
+	    || notification_db_bind_int(stmt, "$sound_type", noti->sound_type)
+	    || notification_db_bind_text(stmt, "$sound_path", noti->sound_path)
+	    || notification_db_bind_int(stmt, "$vibration_type",
+					noti->vibration_type)
+	    || notification_db_bind_text(stmt, "$vibration_path",
+					 noti->vibration_path)
+	    || notification_db_bind_int(stmt, "$flags_for_property",
+					noti->flags_for_property)
+	    || notification_db_bind_int(stmt, "$flag_simmode", flag_simmode)
+	    || notification_db_bind_int(stmt, "$display_applist",
+					noti->display_applist)
+	    || notification_db_bind_double(stmt, "$progress_size",
+					   noti->progress_size)
+	    || notification_db_bind_double(stmt, "$progress_percentage",
+					   noti->progress_percentage)) {
+		ret = NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	return ret;
+}
+
+/* Text column, in arena if it is not NULL */
+static char *_notification_noti_column_string(sqlite3_stmt * stmt, int col,
+					      notification_arena_s * arena)
+{
+	const unsigned char *col_text = NULL;
+
+	if (arena == NULL) {
+		return notification_db_column_text(stmt, col);
+	}
+
+	col_text = sqlite3_column_text(stmt, col);
+	if (col_text == NULL || col_text[0] == '\0') {
+		return NULL;
+	}
+
+	return notification_arena_strdup(arena, (const char *)col_text);
+}
+
+static notification_h _notification_noti_get_item(sqlite3_stmt * stmt,
+						  int fetch_option,
+						  notification_arena_s * arena)
+{
+	notification_h noti = NULL;
 	int col = 0;
+	int i = 0;
 
-	noti = malloc(sizeof(struct _notification));
+	if (arena != NULL) {
+		noti = notification_arena_alloc(arena,
+						sizeof(struct _notification));
+	} else {
+		noti = calloc(1, sizeof(struct _notification));
+	}
 	if (noti == NULL) {
 		return NULL;
 	}
 
+	noti->arena = arena;
+
+	/* Text and key have columns, other bundles are kept encoded,
+	 * decoded when used */
 	noti->type = sqlite3_column_int(stmt, col++);
-	noti->caller_pkgname = notification_db_column_text(stmt, col++);
-	noti->launch_pkgname = notification_db_column_text(stmt, col++);
-	noti->b_image_path = notification_db_column_bundle(stmt, col++);
+	noti->caller_pkgname =
+	    _notification_noti_column_string(stmt, col++, arena);
+	noti->launch_pkgname =
+	    _notification_noti_column_string(stmt, col++, arena);
+	_notification_noti_column_bundle(noti, stmt, col++,
+					 NOTIFICATION_BUNDLE_IMAGE_PATH,
+					 arena);
 	noti->group_id = sqlite3_column_int(stmt, col++);
 	noti->internal_group_id = 0;
 	noti->priv_id = sqlite3_column_int(stmt, col++);
 
-	noti->b_text = notification_db_column_bundle(stmt, col++);
-	noti->b_key = notification_db_column_bundle(stmt, col++);
-	noti->b_format_args = notification_db_column_bundle(stmt, col++);
-	noti->num_format_args = sqlite3_column_int(stmt, col++);
+	for (i = 0; i < NOTIFICATION_TEXT_TYPE_MAX; i++) {
+		noti->text[i] =
+		    _notification_noti_column_string(stmt, col++, arena);
+	}
+	for (i = 0; i < NOTIFICATION_TEXT_TYPE_MAX; i++) {
+		noti->key[i] =
+		    _notification_noti_column_string(stmt, col++, arena);
+	}
+	_notification_noti_column_bundle(noti, stmt, col++,
+					 NOTIFICATION_BUNDLE_FORMAT_ARGS,
+					 arena);
+	/* num_format_args, number of each text type is in the blob */
+	col++;
 
-	noti->domain = notification_db_column_text(stmt, col++);
-	noti->dir = notification_db_column_text(stmt, col++);
+	noti->domain =
+	    _notification_noti_column_string(stmt, col++, arena);
+	noti->dir =
+	    _notification_noti_column_string(stmt, col++, arena);
 	noti->time = sqlite3_column_int(stmt, col++);
 	noti->insert_time = sqlite3_column_int(stmt, col++);
-	noti->args = notification_db_column_bundle(stmt, col++);
-	noti->group_args = notification_db_column_bundle(stmt, col++);
-
-	noti->b_execute_option = notification_db_column_bundle(stmt, col++);
-	noti->b_service_responding = notification_db_column_bundle(stmt, col++);
-	noti->b_service_single_launch =
-	    notification_db_column_bundle(stmt, col++);
-	noti->b_service_multi_launch =
-	    notification_db_column_bundle(stmt, col++);
+	_notification_noti_column_bundle(noti, stmt, col++,
+					 NOTIFICATION_BUNDLE_ARGS,
+					 arena);
+	_notification_noti_column_bundle(noti, stmt, col++,
+					 NOTIFICATION_BUNDLE_GROUP_ARGS,
+					 arena);
+
+	_notification_noti_column_bundle(noti, stmt, col++,
+					 NOTIFICATION_BUNDLE_EXECUTE_OPTION,
+					 arena);
+	_notification_noti_column_bundle(noti, stmt, col++,
+					 NOTIFICATION_BUNDLE_SERVICE_RESPONDING,
+					 arena);
+	_notification_noti_column_bundle(noti, stmt, col++,
+					 NOTIFICATION_BUNDLE_SERVICE_SINGLE_LAUNCH,
+					 arena);
+	_notification_noti_column_bundle(noti, stmt, col++,
+					 NOTIFICATION_BUNDLE_SERVICE_MULTI_LAUNCH,
+					 arena);
 
 	noti->sound_type = sqlite3_column_int(stmt, col++);
-	noti->sound_path = notification_db_column_text(stmt, col++);
+	noti->sound_path =
+	    _notification_noti_column_string(stmt, col++, arena);
 	noti->vibration_type = sqlite3_column_int(stmt, col++);
-	noti->vibration_path = notification_db_column_text(stmt, col++);
+	noti->vibration_path =
+	    _notification_noti_column_string(stmt, col++, arena);
 
 	noti->flags_for_property = sqlite3_column_int(stmt, col++);
 	noti->display_applist = sqlite3_column_int(stmt, col++);
 	noti->progress_size = sqlite3_column_double(stmt, col++);
 	noti->progress_percentage = sqlite3_column_double(stmt, col++);
 
+	noti->rowid = sqlite3_column_int(stmt, col++);
+
+	if (fetch_option & NOTIFICATION_FETCH_OPTION_SUMMARY) {
+		noti->summary = 1;
+	}
+
 	noti->app_icon_path = NULL;
 	noti->app_name = NULL;
 	noti->temp_title = NULL;
@@ -627,70 +1161,87 @@ static notification_h _notification_noti_get_item(sqlite3_stmt * stmt)
 	return noti;
 }
 
-int notification_noti_insert(notification_h noti)
+/* Insert noti, caller holds DB in transaction */
+static int _notification_noti_insert(notification_h noti, sqlite3 * db)
 {
-	sqlite3 *db = NULL;
 	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
 	int ret = 0;
-	char buf_key[32] = { 0, };
 	const char *title_key = NULL;
 
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	/* Read execute option and services before row may change */
+	_notification_noti_load_service(noti);
 
 	/* Get private ID */
 	if (noti->priv_id == NOTIFICATION_PRIV_ID_NONE) {
 		ret = _notification_noti_get_priv_id(noti, db);
 	} else {
 		ret = _notification_noti_check_priv_id(noti, db);
-		if (ret != NOTIFICATION_ERROR_NONE) {
-			goto err;
+		if (ret == NOTIFICATION_ERROR_NONE) {
+			ret = _notification_noti_use_priv_id(noti, db);
 		}
 	}
-
-	/* Get internal group ID */
-	ret = _notification_noti_get_internal_group_id(noti, db);
 	if (ret != NOTIFICATION_ERROR_NONE) {
-		goto err;
+		return ret;
 	}
 
-	/* make query */
-	ret = _notification_noti_make_query(noti, query, sizeof(query));
+	/* Get internal group ID */
+	ret = _notification_noti_get_internal_group_id(noti, db);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		goto err;
 	}
 
-	ret = sqlite3_prepare_v2(db, query, -1, &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Insert Query : %s", query);
-		NOTIFICATION_ERR("Insert DB error(%d) : %s", ret,
-				 sqlite3_errmsg(db));
+	stmt = notification_db_prepare(db, "insert into noti_list ("
+				       "type, "
+				       "caller_pkgname, launch_pkgname, "
+				       "image_path, "
+				       "group_id, internal_group_id, priv_id, "
+				       "title_key, "
+				       NOTIFICATION_NOTI_TEXT_COLUMNS
+				       "b_format_args, num_format_args, "
+				       "text_domain, text_dir, "
+				       "time, insert_time, "
+				       "args, group_args, "
+				       "b_execute_option, "
+				       "b_service_responding, b_service_single_launch, b_service_multi_launch, "
+				       "sound_type, sound_path, vibration_type, vibration_path, "
+				       "flags_for_property, flag_simmode, display_applist, "
+				       "progress_size, progress_percentage) values ("
+				       "$type, "
+				       "$caller_pkgname, $launch_pkgname, "
+				       "$image_path, "
+				       "$group_id, $internal_group_id, $priv_id, "
+				       "$title_key, "
+				       NOTIFICATION_NOTI_TEXT_PARAMS
+				       "$b_format_args, $num_format_args, "
+				       "$text_domain, $text_dir, "
+				       "$time, $insert_time, "
+				       "$args, $group_args, "
+				       "$b_execute_option, "
+				       "$b_service_responding, $b_service_single_launch, $b_service_multi_launch, "
+				       "$sound_type, $sound_path, $vibration_type, $vibration_path, "
+				       "$flags_for_property, $flag_simmode, $display_applist, "
+				       "$progress_size, $progress_percentage)");
+	if (stmt == NULL) {
 		ret = NOTIFICATION_ERROR_FROM_DB;
 		goto err;
 	}
 
 	/* Get title key */
-	if (noti->b_key != NULL) {
-		snprintf(buf_key, sizeof(buf_key), "%d",
-			 NOTIFICATION_TEXT_TYPE_TITLE);
+	title_key = _notification_noti_get_title_key(noti);
 
-		title_key = bundle_get_val(noti->b_key, buf_key);
+	/* Bind query */
+	ret = _notification_noti_bind_item(noti, stmt);
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		ret = notification_db_bind_int(stmt, "$group_id",
+					       noti->group_id);
 	}
-
-	if (title_key == NULL && noti->b_text != NULL) {
-		snprintf(buf_key, sizeof(buf_key), "%d",
-			 NOTIFICATION_TEXT_TYPE_TITLE);
-
-		title_key = bundle_get_val(noti->b_text, buf_key);
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		ret = notification_db_bind_int(stmt, "$internal_group_id",
+					       noti->internal_group_id);
 	}
-
-	if (title_key == NULL) {
-		title_key = noti->caller_pkgname;
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		ret = notification_db_bind_text(stmt, "$title_key", title_key);
 	}
-
-	/* Bind query */
-	ret = _notification_noti_bind_query(stmt, "$title_key", title_key);
 	if (ret != NOTIFICATION_ERROR_NONE) {
 		NOTIFICATION_ERR("Bind error : %s", sqlite3_errmsg(db));
 		goto err;
@@ -700,31 +1251,129 @@ int notification_noti_insert(notification_h noti)
 	if (ret == SQLITE_OK || ret == SQLITE_DONE) {
 		ret = NOTIFICATION_ERROR_NONE;
 	} else {
+		NOTIFICATION_ERR("Insert DB error(%d) : %s", ret,
+				 sqlite3_errmsg(db));
 		ret = NOTIFICATION_ERROR_FROM_DB;
 	}
 err:
 	if (stmt) {
-		sqlite3_finalize(stmt);
+		notification_db_finalize(stmt);
+	}
+
+	return ret;
+}
+
+int notification_noti_insert(notification_h noti)
+{
+	sqlite3 *db = NULL;
+	int ret = 0;
+
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
-	/* Close DB */
+	/* IDs and row are written in one transaction */
+	ret = notification_db_begin(db);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		goto err;
+	}
+
+	ret = _notification_noti_insert(noti, db);
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		ret = notification_db_commit(db);
+	}
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		notification_db_rollback(db);
+	}
+
+err:
+	/* Release DB */
 	if (db) {
-		notification_db_close(&db);
+		notification_db_release(&db);
 	}
 
 	return ret;
 }
 
 
+int notification_noti_insert_batch(notification_h * notis, int n)
+{
+	sqlite3 *db = NULL;
+	int *saved_priv_ids = NULL;
+	int priv_id = 0;
+	int ret = 0;
+	int i = 0;
+
+	saved_priv_ids = (int *)malloc(sizeof(int) * n);
+	if (saved_priv_ids == NULL) {
+		return NOTIFICATION_ERROR_NO_MEMORY;
+	}
+
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		free(saved_priv_ids);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	/* All rows are written in one transaction, all or nothing */
+	ret = notification_db_begin(db);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		goto err;
+	}
+
+	for (i = 0; i < n; i++) {
+		saved_priv_ids[i] = notis[i]->priv_id;
+
+		ret = _notification_noti_insert(notis[i], db);
+		if (ret != NOTIFICATION_ERROR_NONE) {
+			NOTIFICATION_ERR("Batch insert failed at %d : %d", i,
+					 ret);
+			i++;
+			break;
+		}
+	}
+
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		ret = notification_db_commit(db);
+	}
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		notification_db_rollback(db);
+
+		/* Nothing is inserted, give back IDs set by caller */
+		while (i-- > 0) {
+			priv_id = notis[i]->priv_id;
+			notis[i]->priv_id = saved_priv_ids[i];
+			notification_list_rehash(notis[i],
+						 notis[i]->caller_pkgname,
+						 priv_id);
+		}
+	}
+
+err:
+	/* Release DB */
+	if (db) {
+		notification_db_release(&db);
+	}
+
+	free(saved_priv_ids);
+
+	return ret;
+}
+
 int notification_noti_update(notification_h noti)
 {
 	sqlite3 *db;
 	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
 	int ret = 0;
 
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
 	/* Check private ID is exist */
 	ret = _notification_noti_check_priv_id(noti, db);
@@ -733,18 +1382,53 @@ int notification_noti_update(notification_h noti)
 		goto err;
 	}
 
-	/* make update query */
-	ret = _notification_noti_make_update_query(noti, query, sizeof(query));
-	if (ret != NOTIFICATION_ERROR_NONE) {
+	/* Keep execute option and services in DB which are not read yet */
+	_notification_noti_load_service(noti);
+
+	stmt = notification_db_prepare(db, "update noti_list set "
+				       "type = $type, "
+				       "launch_pkgname = $launch_pkgname, "
+				       "image_path = $image_path, "
+				       "text_title = $text_title, "
+				       "text_content = $text_content, "
+				       "text_content_off = $text_content_off, "
+				       "text_group_title = $text_group_title, "
+				       "text_group_content = $text_group_content, "
+				       "text_group_content_off = $text_group_content_off, "
+				       "key_title = $key_title, "
+				       "key_content = $key_content, "
+				       "key_content_off = $key_content_off, "
+				       "key_group_title = $key_group_title, "
+				       "key_group_content = $key_group_content, "
+				       "key_group_content_off = $key_group_content_off, "
+				       "b_format_args = $b_format_args, "
+				       "num_format_args = $num_format_args, "
+				       "text_domain = $text_domain, text_dir = $text_dir, "
+				       "time = $time, insert_time = $insert_time, "
+				       "args = $args, group_args = $group_args, "
+				       "b_execute_option = $b_execute_option, "
+				       "b_service_responding = $b_service_responding, "
+				       "b_service_single_launch = $b_service_single_launch, "
+				       "b_service_multi_launch = $b_service_multi_launch, "
+				       "sound_type = $sound_type, sound_path = $sound_path, "
+				       "vibration_type = $vibration_type, "
+				       "vibration_path = $vibration_path, "
+				       "flags_for_property = $flags_for_property, "
+				       "flag_simmode = $flag_simmode, "
+				       "display_applist = $display_applist, "
+				       "progress_size = $progress_size, "
+				       "progress_percentage = $progress_percentage "
+				       "where caller_pkgname = $caller_pkgname "
+				       "and priv_id = $priv_id");
+	if (stmt == NULL) {
+		ret = NOTIFICATION_ERROR_FROM_DB;
 		goto err;
 	}
 
-	ret = sqlite3_prepare_v2(db, query, -1, &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Insert Query : %s", query);
-		NOTIFICATION_ERR("Insert DB error(%d) : %s", ret,
-				 sqlite3_errmsg(db));
-		ret = NOTIFICATION_ERROR_FROM_DB;
+	/* Bind query */
+	ret = _notification_noti_bind_item(noti, stmt);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		NOTIFICATION_ERR("Bind error : %s", sqlite3_errmsg(db));
 		goto err;
 	}
 
@@ -752,382 +1436,891 @@ int notification_noti_update(notification_h noti)
 	if (ret == SQLITE_OK || ret == SQLITE_DONE) {
 		ret = NOTIFICATION_ERROR_NONE;
 	} else {
+		NOTIFICATION_ERR("Update DB error(%d) : %s", ret,
+				 sqlite3_errmsg(db));
+		ret = NOTIFICATION_ERROR_FROM_DB;
+	}
+err:
+	if (stmt) {
+		notification_db_finalize(stmt);
+	}
+
+	/* Release DB */
+	if (db) {
+		notification_db_release(&db);
+	}
+
+	return ret;
+}
+
+int notification_noti_delete_all(notification_type_e type, const char *pkgname,
+				 int *num_deleted)
+{
+	sqlite3 *db = NULL;
+	sqlite3_stmt *stmt = NULL;
+	const char *query = NULL;
+	int ret = NOTIFICATION_ERROR_NONE;
+
+	if (num_deleted != NULL) {
+		*num_deleted = 0;
+	}
+
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	/* Make query */
+	if (pkgname == NULL) {
+		if (type != NOTIFICATION_TYPE_NONE) {
+			query = "delete from noti_list where type = $type";
+		} else {
+			query = "delete from noti_list";
+		}
+	} else {
+		if (type == NOTIFICATION_TYPE_NONE) {
+			query = "delete from noti_list "
+			    "where caller_pkgname = $caller_pkgname";
+		} else {
+			query = "delete from noti_list "
+			    "where caller_pkgname = $caller_pkgname and type = $type";
+		}
+	}
+
+	stmt = notification_db_prepare(db, query);
+	if (stmt == NULL) {
+		goto err;
+	}
+
+	if (pkgname != NULL) {
+		ret = notification_db_bind_text(stmt, "$caller_pkgname",
+						pkgname);
+	}
+	if (ret == NOTIFICATION_ERROR_NONE && type != NOTIFICATION_TYPE_NONE) {
+		ret = notification_db_bind_int(stmt, "$type", type);
+	}
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		goto err;
+	}
+
+	/* execute DB */
+	ret = sqlite3_step(stmt);
+	if (ret != SQLITE_DONE) {
+		NOTIFICATION_ERR("Delete DB error(%d) : %s", ret,
+				 sqlite3_errmsg(db));
+	} else if (num_deleted != NULL) {
+		*num_deleted = sqlite3_changes(db);
+	}
+
+err:
+	if (stmt) {
+		notification_db_finalize(stmt);
+	}
+
+	/* Release DB */
+	if (db) {
+		notification_db_release(&db);
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+/* Delete rows of pkgname where column = id, priv_ids of the rows are
+ * returned in list_deleted if not NULL, caller frees it */
+static int _notification_noti_delete_group(sqlite3 * db, const char *pkgname,
+					   const char *column, int id,
+					   int *num_deleted, int **list_deleted)
+{
+	sqlite3_stmt *stmt = NULL;
+	char query[NOTIFICATION_QUERY_MAX] = { 0, };
+	char bind_name[32] = { 0, };
+	int *list = NULL;
+	int *list_new = NULL;
+	int num = 0;
+	int ret = NOTIFICATION_ERROR_NONE;
+
+	snprintf(bind_name, sizeof(bind_name), "$%s", column);
+
+	if (list_deleted != NULL) {
+		snprintf(query, sizeof(query), "select priv_id from noti_list "
+			 "where caller_pkgname = $caller_pkgname and %s = %s",
+			 column, bind_name);
+
+		stmt = notification_db_prepare(db, query);
+		if (stmt == NULL) {
+			return NOTIFICATION_ERROR_FROM_DB;
+		}
+
+		if (notification_db_bind_text(stmt, "$caller_pkgname",
+					      pkgname) != NOTIFICATION_ERROR_NONE
+		    || notification_db_bind_int(stmt, bind_name,
+						id) != NOTIFICATION_ERROR_NONE) {
+			ret = NOTIFICATION_ERROR_FROM_DB;
+			goto err;
+		}
+
+		while (sqlite3_step(stmt) == SQLITE_ROW) {
+			list_new = realloc(list, sizeof(int) * (num + 1));
+			if (list_new == NULL) {
+				ret = NOTIFICATION_ERROR_NO_MEMORY;
+				goto err;
+			}
+
+			list = list_new;
+			list[num++] = sqlite3_column_int(stmt, 0);
+		}
+
+		notification_db_finalize(stmt);
+		stmt = NULL;
+	}
+
+	/* Make query */
+	snprintf(query, sizeof(query), "delete from noti_list "
+		 "where caller_pkgname = $caller_pkgname and %s = %s",
+		 column, bind_name);
+
+	stmt = notification_db_prepare(db, query);
+	if (stmt == NULL) {
 		ret = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
+	}
+
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, bind_name,
+					id) != NOTIFICATION_ERROR_NONE) {
+		ret = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
+	}
+
+	/* execute DB */
+	if (sqlite3_step(stmt) != SQLITE_DONE) {
+		NOTIFICATION_ERR("Delete DB error : %s", sqlite3_errmsg(db));
+		ret = NOTIFICATION_ERROR_FROM_DB;
+	}
+
+err:
+	if (stmt) {
+		notification_db_finalize(stmt);
+	}
+
+	if (ret == NOTIFICATION_ERROR_NONE && list_deleted != NULL) {
+		*num_deleted = num;
+		*list_deleted = list;
+	} else if (list) {
+		free(list);
+	}
+
+	return ret;
+}
+
+int notification_noti_delete_group_by_group_id(const char *pkgname,
+					       int group_id, int *num_deleted,
+					       int **list_deleted)
+{
+	sqlite3 *db = NULL;
+	int ret = 0;
+
+	/* Check pkgname is valid */
+	if (pkgname == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	/* Rows read and deleted in one transaction */
+	ret = notification_db_begin(db);
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		ret = _notification_noti_delete_group(db, pkgname, "group_id",
+						      group_id, num_deleted,
+						      list_deleted);
+		if (ret == NOTIFICATION_ERROR_NONE) {
+			ret = notification_db_commit(db);
+		}
+		if (ret != NOTIFICATION_ERROR_NONE) {
+			notification_db_rollback(db);
+		}
+	}
+
+	/* Release DB */
+	notification_db_release(&db);
+
+	return ret;
+}
+
+int notification_noti_delete_group_by_priv_id(const char *pkgname, int priv_id,
+					      int *num_deleted,
+					      int **list_deleted)
+{
+	sqlite3 *db = NULL;
+	int internal_group_id = 0;
+	int ret = 0;
+
+	/* Check pkgname is valid */
+	if (pkgname == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	/* Rows read and deleted in one transaction */
+	ret = notification_db_begin(db);
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		/* Get internal group id using priv id */
+		internal_group_id =
+		    _notification_noti_get_internal_group_id_by_priv_id(pkgname,
+									priv_id,
+									db);
+
+		ret = _notification_noti_delete_group(db, pkgname,
+						      "internal_group_id",
+						      internal_group_id,
+						      num_deleted, list_deleted);
+		if (ret == NOTIFICATION_ERROR_NONE) {
+			ret = notification_db_commit(db);
+		}
+		if (ret != NOTIFICATION_ERROR_NONE) {
+			notification_db_rollback(db);
+		}
 	}
+
+	/* Release DB */
+	notification_db_release(&db);
+
+	return ret;
+}
+
+int notification_noti_delete_by_priv_id(const char *pkgname, int priv_id,
+					int *num_deleted)
+{
+	sqlite3 *db = NULL;
+	sqlite3_stmt *stmt = NULL;
+	int ret = 0;
+
+	if (num_deleted != NULL) {
+		*num_deleted = 0;
+	}
+
+	/* Check pkgname is valid */
+	if (pkgname == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	/* Make query */
+	stmt = notification_db_prepare(db, "delete from noti_list "
+				       "where caller_pkgname = $caller_pkgname "
+				       "and priv_id = $priv_id");
+	if (stmt == NULL) {
+		goto err;
+	}
+
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$priv_id",
+					priv_id) != NOTIFICATION_ERROR_NONE) {
+		goto err;
+	}
+
+	/* execute DB */
+	ret = sqlite3_step(stmt);
+	if (ret != SQLITE_DONE) {
+		NOTIFICATION_ERR("Delete DB error(%d) : %s", ret,
+				 sqlite3_errmsg(db));
+	} else if (num_deleted != NULL) {
+		*num_deleted = sqlite3_changes(db);
+	}
+
+err:
+	if (stmt) {
+		notification_db_finalize(stmt);
+	}
+
+	/* Release DB */
+	if (db) {
+		notification_db_release(&db);
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+int notification_noti_delete_batch(const char *pkgname, const int *priv_ids,
+				   int n, int *deleted_ids)
+{
+	sqlite3 *db = NULL;
+	sqlite3_stmt *stmt = NULL;
+	int ret = NOTIFICATION_ERROR_NONE;
+	int deleted = 0;
+	int i = 0;
+
+	/* Check pkgname is valid */
+	if (pkgname == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	ret = notification_db_begin(db);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		goto err;
+	}
+
+	/* Same statement as single delete, stepped once per priv_id */
+	stmt = notification_db_prepare(db, "delete from noti_list "
+				       "where caller_pkgname = $caller_pkgname "
+				       "and priv_id = $priv_id");
+	if (stmt == NULL) {
+		ret = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
+	}
+
+	ret = notification_db_bind_text(stmt, "$caller_pkgname", pkgname);
+
+	for (i = 0; i < n && ret == NOTIFICATION_ERROR_NONE; i++) {
+		ret = notification_db_bind_int(stmt, "$priv_id", priv_ids[i]);
+		if (ret != NOTIFICATION_ERROR_NONE) {
+			break;
+		}
+
+		if (sqlite3_step(stmt) != SQLITE_DONE) {
+			NOTIFICATION_ERR("Delete DB error : %s",
+					 sqlite3_errmsg(db));
+			ret = NOTIFICATION_ERROR_FROM_DB;
+			break;
+		}
+
+		if (sqlite3_changes(db) > 0) {
+			if (deleted_ids != NULL) {
+				deleted_ids[deleted] = priv_ids[i];
+			}
+			deleted++;
+		}
+
+		/* Keep bindings, only rewind */
+		sqlite3_reset(stmt);
+	}
+
+	notification_db_finalize(stmt);
+
+	if (ret == NOTIFICATION_ERROR_NONE) {
+		ret = notification_db_commit(db);
+	}
+
+err:
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		notification_db_rollback(db);
+	}
+
+	/* Release DB */
+	if (db) {
+		notification_db_release(&db);
+	}
+
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
+	}
+
+	return deleted;
+}
+
+notification_error_e notification_noti_get_count(notification_type_e type,
+						 const char *pkgname,
+						 int group_id, int priv_id,
+						 int *count)
+{
+	sqlite3 *db = NULL;
+	sqlite3_stmt *stmt = NULL;
+	char query[NOTIFICATION_QUERY_MAX] = { 0, };
+	const char *query_where = NULL;
+	const char *query_where_more = NULL;
+
+	int ret = 0, get_count = 0, internal_group_id = 0;
+	int status = VCONFKEY_TELEPHONY_SIM_UNKNOWN;
+
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	/* Check current sim status */
+	vconf_get_int(VCONFKEY_TELEPHONY_SIM_SLOT, &status);
+
+	/* Make query, only placeholders are put in the query text
+	 * so that each combination maps to one cached statement */
+	if (pkgname != NULL) {
+		if (priv_id != NOTIFICATION_PRIV_ID_NONE) {
+			internal_group_id =
+			    _notification_noti_get_internal_group_id_by_priv_id
+			    (pkgname, priv_id, db);
+			query_where = "caller_pkgname = $caller_pkgname "
+			    "and internal_group_id = $internal_group_id ";
+		} else if (group_id != NOTIFICATION_GROUP_ID_NONE) {
+			query_where = "caller_pkgname = $caller_pkgname "
+			    "and group_id = $group_id ";
+		} else {
+			query_where = "caller_pkgname = $caller_pkgname ";
+		}
+	}
+
+	if (status == VCONFKEY_TELEPHONY_SIM_INSERTED) {
+		if (type != NOTIFICATION_TYPE_NONE) {
+			query_where_more = "type = $type ";
+		}
+	} else {
+		if (type != NOTIFICATION_TYPE_NONE) {
+			query_where_more = "type = $type and flag_simmode = 0 ";
+		} else {
+			query_where_more = "flag_simmode = 0 ";
+		}
+	}
+
+	/* noti_count has a row per key of where clause, kept by triggers */
+	snprintf(query, sizeof(query), "select sum(count) from noti_count %s%s%s%s",
+		 (query_where || query_where_more) ? "where " : "",
+		 NOTIFICATION_CHECK_STR(query_where),
+		 (query_where && query_where_more) ? "and " : "",
+		 NOTIFICATION_CHECK_STR(query_where_more));
+
+	stmt = notification_db_prepare(db, query);
+	if (stmt == NULL) {
+		ret = NOTIFICATION_ERROR_FROM_DB;
+		goto err;
+	}
+
+	ret = NOTIFICATION_ERROR_NONE;
+	if (pkgname != NULL) {
+		ret = notification_db_bind_text(stmt, "$caller_pkgname",
+						pkgname);
+		if (ret == NOTIFICATION_ERROR_NONE
+		    && priv_id != NOTIFICATION_PRIV_ID_NONE) {
+			ret = notification_db_bind_int(stmt,
+						       "$internal_group_id",
+						       internal_group_id);
+		} else if (ret == NOTIFICATION_ERROR_NONE
+			   && group_id != NOTIFICATION_GROUP_ID_NONE) {
+			ret = notification_db_bind_int(stmt, "$group_id",
+						       group_id);
+		}
+	}
+	if (ret == NOTIFICATION_ERROR_NONE && type != NOTIFICATION_TYPE_NONE) {
+		ret = notification_db_bind_int(stmt, "$type", type);
+	}
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		goto err;
+	}
+
+	ret = sqlite3_step(stmt);
+	if (ret == SQLITE_ROW) {
+		get_count = sqlite3_column_int(stmt, 0);
+	}
+
+	ret = NOTIFICATION_ERROR_NONE;
+
 err:
 	if (stmt) {
-		sqlite3_finalize(stmt);
+		notification_db_finalize(stmt);
 	}
 
-	/* Close DB */
+	/* Release DB */
 	if (db) {
-		notification_db_close(&db);
+		notification_db_release(&db);
 	}
 
+	*count = get_count;
+
 	return ret;
 }
 
-int notification_noti_delete_all(notification_type_e type, const char *pkgname)
+/* Cursor over select of NOTIFICATION_NOTI_SELECT_ITEM rows.
+ * DB is acquired only while a row is read, so other threads may
+ * use DB between notification_noti_cursor_next() calls. */
+struct _notification_cursor {
+	sqlite3_stmt *stmt;
+	int fetch_option;
+	notification_arena_s *arena;	/* Set while a list is read */
+};
+
+static const char *_notification_noti_get_select(int fetch_option)
 {
-	sqlite3 *db = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
-	char query_base[NOTIFICATION_QUERY_MAX] = { 0, };
-	char query_where[NOTIFICATION_QUERY_MAX] = { 0, };
+	if (fetch_option & NOTIFICATION_FETCH_OPTION_SUMMARY) {
+		return NOTIFICATION_NOTI_SELECT_SUMMARY;
+	}
 
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	return NOTIFICATION_NOTI_SELECT_ITEM;
+}
 
-	/* Make query */
-	snprintf(query_base, sizeof(query_base), "delete from noti_list ");
+static const char *_notification_noti_get_list_where(notification_type_e type)
+{
+	int status = VCONFKEY_TELEPHONY_SIM_UNKNOWN;
 
-	if (pkgname == NULL) {
+	/* Check current sim status */
+	vconf_get_int(VCONFKEY_TELEPHONY_SIM_SLOT, &status);
+
+	if (status == VCONFKEY_TELEPHONY_SIM_INSERTED) {
 		if (type != NOTIFICATION_TYPE_NONE) {
-			snprintf(query_where, sizeof(query_where),
-				 "where type = %d ", type);
-		}
-	} else {
-		if (type == NOTIFICATION_TYPE_NONE) {
-			snprintf(query_where, sizeof(query_where),
-				 "where caller_pkgname = '%s' ", pkgname);
-		} else {
-			snprintf(query_where, sizeof(query_where),
-				 "where caller_pkgname = '%s' and type = %d ",
-				 pkgname, type);
+			return "and type = $type ";
 		}
+		return "";
 	}
 
-	snprintf(query, sizeof(query), "%s %s", query_base, query_where);
-
-	//NOTIFICATION_INFO("Delete All : [%s]", query);
-
-	/* execute DB */
-	notification_db_exec(db, query);
-
-	/* Close DB */
-	if (db) {
-		notification_db_close(&db);
+	if (type != NOTIFICATION_TYPE_NONE) {
+		return "and type = $type and flag_simmode = 0 ";
 	}
-
-	return NOTIFICATION_ERROR_NONE;
+	return "and flag_simmode = 0 ";
 }
 
-int notification_noti_delete_group_by_group_id(const char *pkgname,
-					       int group_id)
+/* If page_rowid is > 0, newest row of each group older than page_rowid,
+ * else grouping list from the top. count -1 is no limit */
+static sqlite3_stmt *_notification_noti_prepare_grouping(sqlite3 * db,
+							 int fetch_option,
+							 notification_type_e type,
+							 int count,
+							 int page_rowid)
 {
-	sqlite3 *db = NULL;
+	sqlite3_stmt *stmt = NULL;
 	char query[NOTIFICATION_QUERY_MAX] = { 0, };
-
-	/* Check pkgname is valid */
-	if (pkgname == NULL) {
-		return NOTIFICATION_ERROR_INVALID_DATA;
-	}
-
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	const char *query_where = NULL;
 
 	/* Make query */
-	snprintf(query, sizeof(query), "delete from noti_list "
-		 "where caller_pkgname = '%s' and group_id = %d", pkgname,
-		 group_id);
+	query_where = _notification_noti_get_list_where(type);
 
-	/* execute DB */
-	notification_db_exec(db, query);
+	if (page_rowid > 0) {
+		/* Walk rowid index down from page_rowid, same filter is applied
+		 * to newer rows of the group, names there resolve to newer */
+		snprintf(query, sizeof(query),
+			 "%s where rowid < $rowid %s"
+			 "and not exists (select 1 from noti_list newer "
+			 "where newer.internal_group_id = noti_list.internal_group_id "
+			 "and newer.rowid > noti_list.rowid %s) "
+			 "order by rowid desc "
+			 "limit $count",
+			 _notification_noti_get_select(fetch_option), query_where,
+			 query_where);
+	} else {
+		snprintf(query, sizeof(query),
+			 "%s where 1 %s"
+			 "group by internal_group_id "
+			 "order by rowid desc, time desc "
+			 "limit $count",
+			 _notification_noti_get_select(fetch_option), query_where);
+	}
 
-	/* Close DB */
-	if (db) {
-		notification_db_close(&db);
+	stmt = notification_db_prepare_cursor(db, query);
+	if (stmt == NULL) {
+		return NULL;
 	}
 
-	return NOTIFICATION_ERROR_NONE;
+	if ((type != NOTIFICATION_TYPE_NONE
+	     && notification_db_bind_int(stmt, "$type",
+					 type) != NOTIFICATION_ERROR_NONE)
+	    || (page_rowid > 0
+		&& notification_db_bind_int(stmt, "$rowid",
+					    page_rowid) != NOTIFICATION_ERROR_NONE)
+	    || notification_db_bind_int(stmt, "$count",
+					count) != NOTIFICATION_ERROR_NONE) {
+		notification_db_finalize_cursor(stmt);
+		return NULL;
+	}
+
+	return stmt;
 }
 
-int notification_noti_delete_group_by_priv_id(const char *pkgname, int priv_id)
+static sqlite3_stmt *_notification_noti_prepare_detail(sqlite3 * db,
+						       int fetch_option,
+						       const char *pkgname,
+						       int priv_id, int count)
 {
-	sqlite3 *db = NULL;
+	sqlite3_stmt *stmt = NULL;
 	char query[NOTIFICATION_QUERY_MAX] = { 0, };
+	const char *query_where = NULL;
 	int internal_group_id = 0;
+	int status = VCONFKEY_TELEPHONY_SIM_UNKNOWN;
 
-	/* Check pkgname is valid */
-	if (pkgname == NULL) {
-		return NOTIFICATION_ERROR_INVALID_DATA;
-	}
-
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	/* Check current sim status */
+	vconf_get_int(VCONFKEY_TELEPHONY_SIM_SLOT, &status);
 
-	/* Get internal group id using priv id */
 	internal_group_id =
 	    _notification_noti_get_internal_group_id_by_priv_id(pkgname,
 								priv_id, db);
 
 	/* Make query */
-	snprintf(query, sizeof(query), "delete from noti_list "
-		 "where caller_pkgname = '%s' and internal_group_id = %d",
-		 pkgname, internal_group_id);
+	if (status == VCONFKEY_TELEPHONY_SIM_INSERTED) {
+		query_where = "";
+	} else {
+		query_where = "and flag_simmode = 0 ";
+	}
 
-	/* execute DB */
-	notification_db_exec(db, query);
+	snprintf(query, sizeof(query),
+		 "%s where caller_pkgname = $caller_pkgname "
+		 "and internal_group_id = $internal_group_id %s"
+		 "order by rowid desc, time desc "
+		 "limit $count",
+		 _notification_noti_get_select(fetch_option), query_where);
+
+	stmt = notification_db_prepare_cursor(db, query);
+	if (stmt == NULL) {
+		return NULL;
+	}
 
-	/* Close DB */
-	if (db) {
-		notification_db_close(&db);
+	if (notification_db_bind_text(stmt, "$caller_pkgname",
+				      pkgname) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$internal_group_id",
+					internal_group_id) != NOTIFICATION_ERROR_NONE
+	    || notification_db_bind_int(stmt, "$count",
+					count) != NOTIFICATION_ERROR_NONE) {
+		notification_db_finalize_cursor(stmt);
+		return NULL;
 	}
 
-	return NOTIFICATION_ERROR_NONE;
+	return stmt;
 }
 
-int notification_noti_delete_by_priv_id(const char *pkgname, int priv_id)
+notification_error_e notification_noti_cursor_open_grouping(notification_type_e type,
+							    int count,
+							    int page_rowid,
+							    int fetch_option,
+							    notification_cursor_h *cursor)
 {
 	sqlite3 *db = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
+	notification_cursor_h new_cursor = NULL;
 
-	/* Check pkgname is valid */
-	if (pkgname == NULL) {
-		return NOTIFICATION_ERROR_INVALID_DATA;
+	new_cursor = (notification_cursor_h) calloc(1, sizeof(*new_cursor));
+	if (new_cursor == NULL) {
+		return NOTIFICATION_ERROR_NO_MEMORY;
 	}
 
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		free(new_cursor);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
-	/* Make query */
-	snprintf(query, sizeof(query), "delete from noti_list "
-		 "where caller_pkgname = '%s' and priv_id = %d", pkgname,
-		 priv_id);
+	new_cursor->fetch_option = fetch_option;
+	new_cursor->stmt = _notification_noti_prepare_grouping(db,
+							       new_cursor->fetch_option,
+							       type, count,
+							       page_rowid);
 
-	/* execute DB */
-	notification_db_exec(db, query);
+	/* Release DB */
+	notification_db_release(&db);
 
-	/* Close DB */
-	if (db) {
-		notification_db_close(&db);
+	if (new_cursor->stmt == NULL) {
+		free(new_cursor);
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
+	*cursor = new_cursor;
+
 	return NOTIFICATION_ERROR_NONE;
 }
 
-notification_error_e notification_noti_get_count(notification_type_e type,
-						 const char *pkgname,
-						 int group_id, int priv_id,
-						 int *count)
+notification_error_e notification_noti_cursor_open_detail(const char *pkgname,
+							   int group_id,
+							   int priv_id,
+							   int count,
+							   int fetch_option,
+							   notification_cursor_h *cursor)
 {
 	sqlite3 *db = NULL;
-	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
-	char query_base[NOTIFICATION_QUERY_MAX] = { 0, };
-	char query_where[NOTIFICATION_QUERY_MAX] = { 0, };
-	char query_where_more[NOTIFICATION_QUERY_MAX] = { 0, };
+	notification_cursor_h new_cursor = NULL;
 
-	int ret = 0, get_count = 0, internal_group_id = 0;
-	int status = VCONFKEY_TELEPHONY_SIM_UNKNOWN;
-	int flag_where = 0;
-	int flag_where_more = 0;
+	new_cursor = (notification_cursor_h) calloc(1, sizeof(*new_cursor));
+	if (new_cursor == NULL) {
+		return NOTIFICATION_ERROR_NO_MEMORY;
+	}
 
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		free(new_cursor);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
-	/* Check current sim status */
-	vconf_get_int(VCONFKEY_TELEPHONY_SIM_SLOT, &status);
+	new_cursor->fetch_option = fetch_option;
+	new_cursor->stmt = _notification_noti_prepare_detail(db,
+							     new_cursor->fetch_option,
+							     pkgname, priv_id,
+							     count);
 
-	/* Make query */
-	snprintf(query_base, sizeof(query_base),
-		 "select count(*) from noti_list ");
+	/* Release DB */
+	notification_db_release(&db);
 
-	if (pkgname != NULL) {
-		if (group_id == NOTIFICATION_GROUP_ID_NONE) {
-			if (priv_id == NOTIFICATION_PRIV_ID_NONE) {
-				snprintf(query_where, sizeof(query_where),
-					 "where caller_pkgname = '%s' ",
-					 pkgname);
-				flag_where = 1;
-			} else {
-				internal_group_id =
-				    _notification_noti_get_internal_group_id_by_priv_id
-				    (pkgname, priv_id, db);
-				snprintf(query_where, sizeof(query_where),
-					 "where caller_pkgname = '%s' and internal_group_id = %d ",
-					 pkgname, internal_group_id);
-				flag_where = 1;
-			}
-		} else {
-			if (priv_id == NOTIFICATION_PRIV_ID_NONE) {
-				snprintf(query_where, sizeof(query_where),
-					 "where caller_pkgname = '%s' and group_id = %d ",
-					 pkgname, group_id);
-				flag_where = 1;
-			} else {
-				internal_group_id =
-				    _notification_noti_get_internal_group_id_by_priv_id
-				    (pkgname, priv_id, db);
-				snprintf(query_where, sizeof(query_where),
-					 "where caller_pkgname = '%s' and internal_group_id = %d ",
-					 pkgname, internal_group_id);
-				flag_where = 1;
-			}
-		}
+	if (new_cursor->stmt == NULL) {
+		free(new_cursor);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
+
+	*cursor = new_cursor;
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+notification_error_e notification_noti_cursor_next(notification_cursor_h cursor,
+						   notification_h *noti)
+{
+	sqlite3 *db = NULL;
+	notification_h get_noti = NULL;
+	int ret = 0;
 
+	*noti = NULL;
+
+	/* Cursor reached end */
+	if (cursor->stmt == NULL) {
+		return NOTIFICATION_ERROR_NONE;
 	}
 
-	if (status == VCONFKEY_TELEPHONY_SIM_INSERTED) {
-		if (type != NOTIFICATION_TYPE_NONE) {
-			snprintf(query_where_more, sizeof(query_where_more),
-				 "type = %d ", type);
-			flag_where_more = 1;
-		}
-	} else {
-		if (type != NOTIFICATION_TYPE_NONE) {
-			snprintf(query_where_more, sizeof(query_where_more),
-				 "type = %d and flag_simmode = 0 ", type);
-			flag_where_more = 1;
-		} else {
-			snprintf(query_where_more, sizeof(query_where_more),
-				 "flag_simmode = 0 ");
-			flag_where_more = 1;
-		}
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
-	if (flag_where == 1) {
-		if (flag_where_more == 1) {
-			snprintf(query, sizeof(query), "%s %s and %s",
-				 query_base, query_where, query_where_more);
-		} else {
-			snprintf(query, sizeof(query), "%s %s", query_base,
-				 query_where);
+	ret = sqlite3_step(cursor->stmt);
+	while (ret == SQLITE_ROW) {
+		/* Make notification, skip broken row */
+		get_noti = _notification_noti_get_item(cursor->stmt,
+						       cursor->fetch_option,
+						       cursor->arena);
+		if (get_noti != NULL) {
+			break;
 		}
 
-	} else {
-		if (flag_where_more == 1) {
-			snprintf(query, sizeof(query), "%s where %s",
-				 query_base, query_where_more);
-		} else {
-			snprintf(query, sizeof(query), "%s", query_base);
-		}
+		ret = sqlite3_step(cursor->stmt);
 	}
 
-	ret = sqlite3_prepare(db, query, strlen(query), &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Select Query : %s", query);
-		NOTIFICATION_ERR("Select DB error(%d) : %s", ret,
-				 sqlite3_errmsg(db));
+	if (ret != SQLITE_ROW) {
+		if (ret != SQLITE_DONE) {
+			NOTIFICATION_ERR("Select DB error(%d) : %s", ret,
+					 sqlite3_errmsg(db));
+		}
 
-		ret = NOTIFICATION_ERROR_FROM_DB;
-		goto err;
+		/* Give statement back as soon as possible */
+		notification_db_finalize_cursor(cursor->stmt);
+		cursor->stmt = NULL;
 	}
 
-	ret = sqlite3_step(stmt);
-	if (ret == SQLITE_ROW) {
-		get_count = sqlite3_column_int(stmt, 0);
-	}
+	/* Release DB */
+	notification_db_release(&db);
 
-	ret = NOTIFICATION_ERROR_NONE;
+	*noti = get_noti;
 
-err:
-	if (stmt) {
-		sqlite3_finalize(stmt);
+	if (ret != SQLITE_ROW && ret != SQLITE_DONE) {
+		return NOTIFICATION_ERROR_FROM_DB;
 	}
 
-	/* Close DB */
-	if (db) {
-		notification_db_close(&db);
+	return NOTIFICATION_ERROR_NONE;
+}
+
+notification_error_e notification_noti_cursor_close(notification_cursor_h cursor)
+{
+	sqlite3 *db = NULL;
+
+	if (cursor->stmt != NULL) {
+		/* Get DB */
+		db = notification_db_acquire();
+
+		notification_db_finalize_cursor(cursor->stmt);
+		cursor->stmt = NULL;
+
+		/* Release DB */
+		if (db) {
+			notification_db_release(&db);
+		}
 	}
 
-	*count = get_count;
+	free(cursor);
 
-	return ret;
+	return NOTIFICATION_ERROR_NONE;
 }
 
-notification_error_e notification_noti_get_grouping_list(notification_type_e type,
-							 int count,
-							 notification_list_h *
-							 list)
+/* Read rows of cursor into list and close cursor. DB is held until the
+ * list is read, so no statement of other thread (e.g. rollback of
+ * failed insert) runs between rows. Partial list is not returned. */
+static notification_error_e _notification_noti_cursor_get_list(notification_cursor_h cursor,
+							       int count,
+							       notification_list_h *list)
 {
 	sqlite3 *db = NULL;
-	sqlite3_stmt *stmt = NULL;
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
-	char query_base[NOTIFICATION_QUERY_MAX] = { 0, };
-	char query_where[NOTIFICATION_QUERY_MAX] = { 0, };
-
-	int ret = 0;
 	notification_list_h get_list = NULL;
+	notification_list_h new_list = NULL;
+	notification_arena_s *arena = NULL;
 	notification_h noti = NULL;
 	int internal_count = 0;
-	int status;
-
-	/* Open DB */
-	db = notification_db_open(DBPATH);
-
-	/* Check current sim status */
-	ret = vconf_get_int(VCONFKEY_TELEPHONY_SIM_SLOT, &status);
+	int ret = NOTIFICATION_ERROR_NONE;
 
-	/* Make query */
-	snprintf(query_base, sizeof(query_base), "select "
-		 "type, caller_pkgname, launch_pkgname, image_path, group_id, priv_id, "
-		 "b_text, b_key, b_format_args, num_format_args, "
-		 "text_domain, text_dir, time, insert_time, args, group_args, "
-		 "b_execute_option, b_service_responding, b_service_single_launch, b_service_multi_launch, "
-		 "sound_type, sound_path, vibration_type, vibration_path, "
-		 "flags_for_property, display_applist, progress_size, progress_percentage "
-		 "from noti_list ");
+	/* Get DB */
+	db = notification_db_acquire();
+	if (db == NULL) {
+		notification_noti_cursor_close(cursor);
+		return NOTIFICATION_ERROR_FROM_DB;
+	}
 
-	if (status == VCONFKEY_TELEPHONY_SIM_INSERTED) {
-		if (type != NOTIFICATION_TYPE_NONE) {
-			snprintf(query_where, sizeof(query_where),
-				 "where type = %d ", type);
-		}
-	} else {
-		if (type != NOTIFICATION_TYPE_NONE) {
-			snprintf(query_where, sizeof(query_where),
-				 "where type = %d and flag_simmode = 0 ", type);
-		} else {
-			snprintf(query_where, sizeof(query_where),
-				 "where flag_simmode = 0 ");
+	/* Notifications of list are freed at once with it, it is not done
+	 * for cursor as its notifications are freed one by one */
+	if (cursor->fetch_option & NOTIFICATION_FETCH_OPTION_ARENA) {
+		arena = notification_arena_create();
+		if (arena == NULL) {
+			ret = NOTIFICATION_ERROR_NO_MEMORY;
+			goto out;
 		}
+		cursor->arena = arena;
 	}
 
-	snprintf(query, sizeof(query),
-		 "%s %s "
-		 "group by internal_group_id "
-		 "order by rowid desc, time desc", query_base, query_where);
-
-	ret = sqlite3_prepare(db, query, strlen(query), &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Select Query : %s", query);
-		NOTIFICATION_ERR("Select DB error(%d) : %s", ret,
-				 sqlite3_errmsg(db));
-
-		ret = NOTIFICATION_ERROR_FROM_DB;
-		goto err;
-	}
+	while (count == -1 || internal_count < count) {
+		ret = notification_noti_cursor_next(cursor, &noti);
+		if (ret != NOTIFICATION_ERROR_NONE || noti == NULL) {
+			break;
+		}
 
-	ret = sqlite3_step(stmt);
-	while (ret == SQLITE_ROW) {
 		/* Make notification list */
-		noti = _notification_noti_get_item(stmt);
-		if (noti != NULL) {
-			internal_count++;
-
-			get_list = notification_list_append(get_list, noti);
+		internal_count++;
 
-			if (count != -1 && internal_count >= count) {
-				NOTIFICATION_INFO
-				    ("internal count %d >= count %d",
-				     internal_count, count);
-				break;
-			}
+		new_list = notification_list_append(get_list, noti);
+		if (new_list == NULL) {
+			notification_free(noti);
+			ret = NOTIFICATION_ERROR_NO_MEMORY;
+			break;
 		}
 
-		ret = sqlite3_step(stmt);
+		if (get_list == NULL && arena != NULL) {
+			notification_list_set_arena(new_list, arena);
+		}
+		get_list = new_list;
 	}
 
-	ret = NOTIFICATION_ERROR_NONE;
+out:
+	notification_noti_cursor_close(cursor);
 
-err:
-	if (stmt) {
-		sqlite3_finalize(stmt);
+	if (ret != NOTIFICATION_ERROR_NONE && get_list != NULL) {
+		notification_free_list(get_list);
+		get_list = NULL;
 	}
 
-	/* Close DB */
-	if (db) {
-		notification_db_close(&db);
+	/* Release DB */
+	notification_db_release(&db);
+
+	if (arena != NULL) {
+		notification_arena_unref(arena);
 	}
 
 	if (get_list != NULL) {
@@ -1137,103 +2330,77 @@ err:
 	return ret;
 }
 
-notification_error_e notification_noti_get_detail_list(const char *pkgname,
-						       int group_id,
-						       int priv_id, int count,
-						       notification_list_h *list)
+notification_error_e notification_noti_get_grouping_list(notification_type_e type,
+							 int count,
+							 int fetch_option,
+							 notification_list_h *
+							 list)
 {
-	sqlite3 *db = NULL;
-	sqlite3_stmt *stmt = NULL;
-	char query_base[NOTIFICATION_QUERY_MAX] = { 0, };
-	char query_where[NOTIFICATION_QUERY_MAX] = { 0, };
-
-	char query[NOTIFICATION_QUERY_MAX] = { 0, };
+	notification_cursor_h cursor = NULL;
 	int ret = 0;
-	notification_list_h get_list = NULL;
-	notification_h noti = NULL;
-	int internal_count = 0;
-	int internal_group_id = 0;
-	int status;
 
-	/* Open DB */
-	db = notification_db_open(DBPATH);
+	ret = notification_noti_cursor_open_grouping(type, count, 0,
+						     fetch_option, &cursor);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
+	}
 
-	/* Check current sim status */
-	ret = vconf_get_int(VCONFKEY_TELEPHONY_SIM_SLOT, &status);
+	return _notification_noti_cursor_get_list(cursor, count, list);
+}
 
-	/* Make query */
-	snprintf(query_base, sizeof(query_base), "select "
-		 "type, caller_pkgname, launch_pkgname, image_path, group_id, priv_id, "
-		 "b_text, b_key, b_format_args, num_format_args, "
-		 "text_domain, text_dir, time, insert_time, args, group_args, "
-		 "b_execute_option, b_service_responding, b_service_single_launch, b_service_multi_launch, "
-		 "sound_type, sound_path, vibration_type, vibration_path, "
-		 "flags_for_property, display_applist, progress_size, progress_percentage "
-		 "from noti_list ");
+notification_error_e notification_noti_get_grouping_list_page(notification_type_e type,
+							      int count,
+							      int fetch_option,
+							      notification_page_token_s *token,
+							      notification_list_h *list)
+{
+	notification_cursor_h cursor = NULL;
+	notification_list_h get_list = NULL;
+	notification_h noti = NULL;
+	int page_rowid = 0;
+	int ret = 0;
 
-	internal_group_id =
-	    _notification_noti_get_internal_group_id_by_priv_id(pkgname,
-								priv_id, db);
+	/* First page starts above every row */
+	page_rowid = token->rowid > 0 ? token->rowid : INT_MAX;
 
-	if (status == VCONFKEY_TELEPHONY_SIM_INSERTED) {
-		snprintf(query_where, sizeof(query_where),
-			 "where  caller_pkgname = '%s' and internal_group_id = %d ",
-			 pkgname, internal_group_id);
-	} else {
-		snprintf(query_where, sizeof(query_where),
-			 "where  caller_pkgname = '%s' and internal_group_id = %d and flag_simmode = 0 ",
-			 pkgname, internal_group_id);
+	ret = notification_noti_cursor_open_grouping(type, count, page_rowid,
+						     fetch_option, &cursor);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
 	}
 
-	snprintf(query, sizeof(query),
-		 "%s %s "
-		 "order by rowid desc, time desc", query_base, query_where);
-
-	ret = sqlite3_prepare(db, query, strlen(query), &stmt, NULL);
-	if (ret != SQLITE_OK) {
-		NOTIFICATION_ERR("Select Query : %s", query);
-		NOTIFICATION_ERR("Select DB error(%d) : %s", ret,
-				 sqlite3_errmsg(db));
-
-		ret = NOTIFICATION_ERROR_FROM_DB;
-		goto err;
+	ret = _notification_noti_cursor_get_list(cursor, count, &get_list);
+	if (ret != NOTIFICATION_ERROR_NONE || get_list == NULL) {
+		return ret;
 	}
 
-	ret = sqlite3_step(stmt);
-	while (ret == SQLITE_ROW) {
-		/* Make notification list */
-		noti = _notification_noti_get_item(stmt);
-		if (noti != NULL) {
-			internal_count++;
-
-			get_list = notification_list_append(get_list, noti);
-
-			if (count != -1 && internal_count >= count) {
-				NOTIFICATION_INFO
-				    ("internal count %d >= count %d",
-				     internal_count, count);
-				break;
-			}
-		}
-
-		ret = sqlite3_step(stmt);
+	/* Next page resumes after last notification of this page */
+	noti = notification_list_get_data(notification_list_get_tail(get_list));
+	if (noti != NULL) {
+		token->time = noti->time;
+		token->rowid = noti->rowid;
 	}
 
-	ret = NOTIFICATION_ERROR_NONE;
+	*list = get_list;
 
-err:
-	if (stmt) {
-		sqlite3_finalize(stmt);
-	}
+	return NOTIFICATION_ERROR_NONE;
+}
 
-	/* Close DB */
-	if (db) {
-		notification_db_close(&db);
-	}
+notification_error_e notification_noti_get_detail_list(const char *pkgname,
+						       int group_id,
+						       int priv_id, int count,
+						       int fetch_option,
+						       notification_list_h *list)
+{
+	notification_cursor_h cursor = NULL;
+	int ret = 0;
 
-	if (get_list != NULL) {
-		*list = notification_list_get_head(get_list);
+	ret = notification_noti_cursor_open_detail(pkgname, group_id, priv_id,
+						   count, fetch_option,
+						   &cursor);
+	if (ret != NOTIFICATION_ERROR_NONE) {
+		return ret;
 	}
 
-	return ret;
+	return _notification_noti_cursor_get_list(cursor, count, list);
 }
@@ -22,28 +22,64 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
 
 #include <dbus/dbus.h>
 
 #include <notification_db.h>
 #include <notification_debug.h>
 #include <notification_ongoing.h>
+#include <notification_ipc.h>
+#include <notification_shm.h>
 #include <notification_internal.h>
 
-notification_error_e notification_ongoing_update_progress(const char *caller_pkgname,
-							  int priv_id,
-							  double progress)
+/* Default minimum interval of updates of a notification, in msec */
+#define NOTIFICATION_ONGOING_INTERVAL 100
+
+typedef enum _notification_ongoing_kind {
+	NOTIFICATION_ONGOING_PROGRESS = 0,
+	NOTIFICATION_ONGOING_SIZE,
+	NOTIFICATION_ONGOING_CONTENT,
+} notification_ongoing_kind_e;
+
+/* Latest value of a kind of update of pkgname and priv_id. A value is
+ * sent at once if last one was sent interval ago, otherwise it is kept
+ * and sent by flush thread when interval is over. A newer value
+ * replaces the kept one, the last value is always sent. */
+typedef struct _notification_ongoing_slot {
+	char *pkgname;
+	int priv_id;
+	notification_ongoing_kind_e kind;
+	double value;
+	char *content;
+	int pending;
+	long long sent_time;	/* msec of monotonic clock */
+} notification_ongoing_slot_s;
+
+static pthread_mutex_t g_ongoing_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_ongoing_cond = PTHREAD_COND_INITIALIZER;
+static int g_ongoing_interval = NOTIFICATION_ONGOING_INTERVAL;
+static notification_ongoing_slot_s *g_ongoing_slots = NULL;
+static int g_ongoing_num = 0;
+static int g_ongoing_size = 0;
+static int g_ongoing_thread = 0;
+static pthread_once_t g_ongoing_once = PTHREAD_ONCE_INIT;
+
+static notification_error_e _notification_ongoing_send_progress(const char *caller_pkgname,
+								 int priv_id,
+								 double progress)
 {
-	DBusConnection *connection = NULL;
 	DBusMessage *signal = NULL;
-	DBusError err;
 	dbus_bool_t ret;
+	int exclusive = 0;
 
-	dbus_error_init(&err);
-	connection = dbus_bus_get(DBUS_BUS_SYSTEM, &err);
-	if (!connection) {
-		NOTIFICATION_ERR("Fail to dbus_bus_get");
-		return NOTIFICATION_ERROR_FROM_DBUS;
+	/* Viewer reading shared memory may take it off the bus */
+	if (notification_shm_write(NOTIFICATION_ONGOING_UPDATE_PROGRESS,
+				   caller_pkgname, priv_id,
+				   progress, &exclusive) == NOTIFICATION_ERROR_NONE
+	    && exclusive) {
+		return NOTIFICATION_ERROR_NONE;
 	}
 
 	signal =
@@ -61,10 +97,8 @@ notification_error_e notification_ongoing_update_progress(const char *caller_pkg
 				       DBUS_TYPE_INVALID);
 
 	if (ret) {
-		ret = dbus_connection_send(connection, signal, NULL);
-		if (ret) {
-			dbus_connection_flush(connection);
-		}
+		ret = (notification_ipc_send(signal) ==
+		       NOTIFICATION_ERROR_NONE);
 	}
 
 	dbus_message_unref(signal);
@@ -78,19 +112,20 @@ notification_error_e notification_ongoing_update_progress(const char *caller_pkg
 	return NOTIFICATION_ERROR_FROM_DBUS;
 }
 
-notification_error_e notification_ongoing_update_size(const char *caller_pkgname,
-						      int priv_id, double size)
+static notification_error_e _notification_ongoing_send_size(const char *caller_pkgname,
+							     int priv_id,
+							     double size)
 {
-	DBusConnection *connection = NULL;
 	DBusMessage *signal = NULL;
-	DBusError err;
 	dbus_bool_t ret;
+	int exclusive = 0;
 
-	dbus_error_init(&err);
-	connection = dbus_bus_get(DBUS_BUS_SYSTEM, &err);
-	if (!connection) {
-		NOTIFICATION_ERR("Fail to dbus_bus_get");
-		return NOTIFICATION_ERROR_FROM_DBUS;
+	/* Viewer reading shared memory may take it off the bus */
+	if (notification_shm_write(NOTIFICATION_ONGOING_UPDATE_SIZE,
+				   caller_pkgname, priv_id,
+				   size, &exclusive) == NOTIFICATION_ERROR_NONE
+	    && exclusive) {
+		return NOTIFICATION_ERROR_NONE;
 	}
 
 	signal =
@@ -108,13 +143,8 @@ notification_error_e notification_ongoing_update_size(const char *caller_pkgname
 				       DBUS_TYPE_INVALID);
 	NOTIFICATION_INFO("arg...");
 	if (ret) {
-		ret = dbus_connection_send(connection, signal, NULL);
-		NOTIFICATION_INFO("Send size info : %s(%d) %.2f",
-				  caller_pkgname, priv_id, size);
-
-		if (ret) {
-			dbus_connection_flush(connection);
-		}
+		ret = (notification_ipc_send(signal) ==
+		       NOTIFICATION_ERROR_NONE);
 	}
 
 	dbus_message_unref(signal);
@@ -128,21 +158,13 @@ notification_error_e notification_ongoing_update_size(const char *caller_pkgname
 	return NOTIFICATION_ERROR_FROM_DBUS;
 }
 
-notification_error_e notification_ongoing_update_content(const char *caller_pkgname,
-						      int priv_id, const char *content)
+static notification_error_e _notification_ongoing_send_content(const char *caller_pkgname,
+								int priv_id,
+								const char *content)
 {
-	DBusConnection *connection = NULL;
 	DBusMessage *signal = NULL;
-	DBusError err;
 	dbus_bool_t ret;
 
-	dbus_error_init(&err);
-	connection = dbus_bus_get(DBUS_BUS_SYSTEM, &err);
-	if (!connection) {
-		NOTIFICATION_ERR("Fail to dbus_bus_get");
-		return NOTIFICATION_ERROR_FROM_DBUS;
-	}
-
 	signal =
 	    dbus_message_new_signal("/dbus/signal", "notification.ongoing",
 				    "update_content");
@@ -164,13 +186,10 @@ notification_error_e notification_ongoing_update_content(const char *caller_pkgn
 						   DBUS_TYPE_INVALID);
 	}
 	if (ret) {
-		ret = dbus_connection_send(connection, signal, NULL);
+		ret = (notification_ipc_send(signal) ==
+		       NOTIFICATION_ERROR_NONE);
 		NOTIFICATION_INFO("Send content : %s(%d) %s",
 				  caller_pkgname, priv_id, content);
-
-		if (ret) {
-			dbus_connection_flush(connection);
-		}
 	}
 
 	dbus_message_unref(signal);
@@ -182,3 +201,338 @@ notification_error_e notification_ongoing_update_content(const char *caller_pkgn
 	return NOTIFICATION_ERROR_FROM_DBUS;
 }
 
+
+static notification_error_e _notification_ongoing_send(notification_ongoing_slot_s * slot)
+{
+	switch (slot->kind) {
+	case NOTIFICATION_ONGOING_PROGRESS:
+		return _notification_ongoing_send_progress(slot->pkgname,
+							   slot->priv_id,
+							   slot->value);
+	case NOTIFICATION_ONGOING_SIZE:
+		return _notification_ongoing_send_size(slot->pkgname,
+						       slot->priv_id,
+						       slot->value);
+	case NOTIFICATION_ONGOING_CONTENT:
+		return _notification_ongoing_send_content(slot->pkgname,
+							  slot->priv_id,
+							  slot->content);
+	default:
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+}
+
+static long long _notification_ongoing_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void _notification_ongoing_set_value(notification_ongoing_slot_s * slot,
+					    double value, const char *content)
+{
+	slot->value = value;
+
+	if (slot->content) {
+		free(slot->content);
+		slot->content = NULL;
+	}
+
+	if (content) {
+		slot->content = strdup(content);
+	}
+}
+
+static void _notification_ongoing_remove(int i)
+{
+	free(g_ongoing_slots[i].pkgname);
+	free(g_ongoing_slots[i].content);
+
+	g_ongoing_num--;
+	memmove(&g_ongoing_slots[i], &g_ongoing_slots[i + 1],
+		sizeof(notification_ongoing_slot_s) * (g_ongoing_num - i));
+}
+
+/* Caller holds g_ongoing_lock */
+static notification_ongoing_slot_s *_notification_ongoing_get_slot(notification_ongoing_kind_e kind,
+								   const char *pkgname,
+								   int priv_id)
+{
+	notification_ongoing_slot_s *slots = NULL;
+	notification_ongoing_slot_s *slot = NULL;
+	int size = 0;
+	int i = 0;
+
+	for (i = 0; i < g_ongoing_num; i++) {
+		slot = &g_ongoing_slots[i];
+		if (slot->kind == kind && slot->priv_id == priv_id
+		    && strcmp(slot->pkgname, pkgname) == 0) {
+			return slot;
+		}
+	}
+
+	if (g_ongoing_num == g_ongoing_size) {
+		size = g_ongoing_size ? g_ongoing_size * 2 : 8;
+		slots = realloc(g_ongoing_slots,
+				sizeof(notification_ongoing_slot_s) * size);
+		if (slots == NULL) {
+			return NULL;
+		}
+
+		g_ongoing_slots = slots;
+		g_ongoing_size = size;
+	}
+
+	slot = &g_ongoing_slots[g_ongoing_num];
+	memset(slot, 0, sizeof(notification_ongoing_slot_s));
+
+	slot->pkgname = strdup(pkgname);
+	if (slot->pkgname == NULL) {
+		return NULL;
+	}
+
+	slot->priv_id = priv_id;
+	slot->kind = kind;
+	/* First value is sent at once */
+	slot->sent_time = _notification_ongoing_now() - g_ongoing_interval;
+	g_ongoing_num++;
+
+	return slot;
+}
+
+/* Send pending values due by now, all of them if all is set,
+ * and drop slots idle for interval. Caller holds g_ongoing_lock.
+ * It returns time of next due value or idle slot, -1 if none. */
+static long long _notification_ongoing_flush(int all)
+{
+	notification_ongoing_slot_s *slot = NULL;
+	long long now = _notification_ongoing_now();
+	long long due = 0;
+	long long next = -1;
+	int i = 0;
+
+	for (i = g_ongoing_num - 1; i >= 0; i--) {
+		slot = &g_ongoing_slots[i];
+		due = slot->sent_time + g_ongoing_interval;
+
+		if (slot->pending && (all || due <= now)) {
+			/* Signal is only queued, it is fine under lock */
+			_notification_ongoing_send(slot);
+			slot->pending = 0;
+			slot->sent_time = now;
+			due = now + g_ongoing_interval;
+		} else if (!slot->pending && due <= now) {
+			_notification_ongoing_remove(i);
+			continue;
+		}
+
+		if (next < 0 || due < next) {
+			next = due;
+		}
+	}
+
+	return next;
+}
+
+static void *_notification_ongoing_flush_thread(void *data)
+{
+	struct timespec ts;
+	long long next = 0;
+	long long wait = 0;
+
+	pthread_mutex_lock(&g_ongoing_lock);
+
+	while (1) {
+		next = _notification_ongoing_flush(0);
+		if (next < 0) {
+			pthread_cond_wait(&g_ongoing_cond, &g_ongoing_lock);
+			continue;
+		}
+
+		wait = next - _notification_ongoing_now();
+		if (wait <= 0) {
+			continue;
+		}
+
+		clock_gettime(CLOCK_REALTIME, &ts);
+		ts.tv_sec += wait / 1000;
+		ts.tv_nsec += (wait % 1000) * 1000000;
+		if (ts.tv_nsec >= 1000000000) {
+			ts.tv_sec++;
+			ts.tv_nsec -= 1000000000;
+		}
+
+		pthread_cond_timedwait(&g_ongoing_cond, &g_ongoing_lock, &ts);
+	}
+
+	return NULL;
+}
+
+static void _notification_ongoing_exit(void)
+{
+	/* Last values are not lost at exit */
+	pthread_mutex_lock(&g_ongoing_lock);
+	_notification_ongoing_flush(1);
+	pthread_mutex_unlock(&g_ongoing_lock);
+}
+
+static void _notification_ongoing_atfork_prepare(void)
+{
+	pthread_mutex_lock(&g_ongoing_lock);
+}
+
+static void _notification_ongoing_atfork_parent(void)
+{
+	pthread_mutex_unlock(&g_ongoing_lock);
+}
+
+static void _notification_ongoing_atfork_child(void)
+{
+	int i = 0;
+
+	/* Flush thread is not running in child, and pending values are
+	 * the parent's to send. Drop them, child starts its own thread. */
+	for (i = 0; i < g_ongoing_num; i++) {
+		free(g_ongoing_slots[i].pkgname);
+		free(g_ongoing_slots[i].content);
+	}
+	free(g_ongoing_slots);
+	g_ongoing_slots = NULL;
+	g_ongoing_num = 0;
+	g_ongoing_size = 0;
+	g_ongoing_thread = 0;
+	pthread_cond_init(&g_ongoing_cond, NULL);
+
+	pthread_mutex_unlock(&g_ongoing_lock);
+}
+
+static void _notification_ongoing_init_once(void)
+{
+	/* Values are sent under g_ongoing_lock, lock of bus must be
+	 * taken after it before fork(), so bus registers first */
+	notification_ipc_init();
+
+	pthread_atfork(_notification_ongoing_atfork_prepare,
+		       _notification_ongoing_atfork_parent,
+		       _notification_ongoing_atfork_child);
+
+	atexit(_notification_ongoing_exit);
+}
+
+static notification_error_e _notification_ongoing_update(notification_ongoing_kind_e kind,
+							 const char *caller_pkgname,
+							 int priv_id,
+							 double value,
+							 const char *content)
+{
+	notification_ongoing_slot_s *slot = NULL;
+	notification_ongoing_slot_s sent = { 0, };
+	pthread_t thread;
+	long long now = 0;
+
+	if (caller_pkgname == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	sent.pkgname = (char *)caller_pkgname;
+	sent.priv_id = priv_id;
+	sent.kind = kind;
+	sent.value = value;
+	sent.content = (char *)content;
+
+	pthread_once(&g_ongoing_once, _notification_ongoing_init_once);
+
+	pthread_mutex_lock(&g_ongoing_lock);
+
+	if (g_ongoing_interval <= 0) {
+		pthread_mutex_unlock(&g_ongoing_lock);
+		return _notification_ongoing_send(&sent);
+	}
+
+	slot = _notification_ongoing_get_slot(kind, caller_pkgname, priv_id);
+	if (slot == NULL) {
+		/* No memory to keep it, send as it is */
+		pthread_mutex_unlock(&g_ongoing_lock);
+		return _notification_ongoing_send(&sent);
+	}
+
+	now = _notification_ongoing_now();
+	if (!slot->pending && now - slot->sent_time >= g_ongoing_interval) {
+		slot->sent_time = now;
+		pthread_mutex_unlock(&g_ongoing_lock);
+		return _notification_ongoing_send(&sent);
+	}
+
+	_notification_ongoing_set_value(slot, value, content);
+	slot->pending = 1;
+
+	if (g_ongoing_thread == 0) {
+		if (pthread_create(&thread, NULL,
+				   _notification_ongoing_flush_thread,
+				   NULL) == 0) {
+			pthread_detach(thread);
+			g_ongoing_thread = 1;
+		} else {
+			/* Nobody flushes it, send now */
+			NOTIFICATION_ERR("Fail to create flush thread");
+			slot->pending = 0;
+			slot->sent_time = now;
+			pthread_mutex_unlock(&g_ongoing_lock);
+			return _notification_ongoing_send(&sent);
+		}
+	}
+
+	pthread_cond_signal(&g_ongoing_cond);
+	pthread_mutex_unlock(&g_ongoing_lock);
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+notification_error_e notification_ongoing_update_progress(const char *caller_pkgname,
+							  int priv_id,
+							  double progress)
+{
+	return _notification_ongoing_update(NOTIFICATION_ONGOING_PROGRESS,
+					    caller_pkgname, priv_id, progress,
+					    NULL);
+}
+
+notification_error_e notification_ongoing_update_size(const char *caller_pkgname,
+						      int priv_id, double size)
+{
+	return _notification_ongoing_update(NOTIFICATION_ONGOING_SIZE,
+					    caller_pkgname, priv_id, size,
+					    NULL);
+}
+
+notification_error_e notification_ongoing_update_content(const char *caller_pkgname,
+						      int priv_id, const char *content)
+{
+	return _notification_ongoing_update(NOTIFICATION_ONGOING_CONTENT,
+					    caller_pkgname, priv_id, 0.0,
+					    content);
+}
+
+notification_error_e notification_ongoing_set_interval(int msec)
+{
+	if (msec < 0) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	pthread_mutex_lock(&g_ongoing_lock);
+
+	g_ongoing_interval = msec;
+
+	/* Values kept for old interval are sent by new one */
+	if (msec == 0) {
+		_notification_ongoing_flush(1);
+	}
+	pthread_cond_signal(&g_ongoing_cond);
+
+	pthread_mutex_unlock(&g_ongoing_lock);
+
+	return NOTIFICATION_ERROR_NONE;
+}
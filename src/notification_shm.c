@@ -0,0 +1,425 @@
+/*
+ *  libnotification
+ *
+ * Copyright (c) 2000 - 2011 Samsung Electronics Co., Ltd. All rights reserved.
+ *
+ * Contact: Seungtaek Chung <seungtaek.chung@samsung.com>, Mi-Ju Lee <miju52.lee@samsung.com>, Xi Zhichan <zhichan.xi@samsung.com>, Youngsub Ko <ys4610.ko@samsung.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include <notification_error.h>
+#include <notification_debug.h>
+#include <notification_shm.h>
+
+#define NOTIFICATION_SHM_MAGIC 0x4e4f4e48	/* "NONH" */
+#define NOTIFICATION_SHM_RECORDS 256
+#define NOTIFICATION_SHM_PKGNAME_LEN 128
+/* Writers look for a viewer at most once in this, in sec */
+#define NOTIFICATION_SHM_CHECK_INTERVAL 1
+/* Applications write to ring by group of DB, never by other users */
+#define NOTIFICATION_SHM_GID 5000
+#define NOTIFICATION_SHM_MODE 0660
+
+/* Record i of ring is written in records[i % NOTIFICATION_SHM_RECORDS].
+ * seq is odd while it is written, i * 2 + 2 when it is done, so viewer
+ * copies it without lock and drops it if seq changed under the copy. */
+typedef struct _notification_shm_record {
+	volatile unsigned int seq;
+	int type;
+	int priv_id;
+	double value;
+	char pkgname[NOTIFICATION_SHM_PKGNAME_LEN];
+} notification_shm_record_s;
+
+/* Viewer holds write lock on first byte of object while it reads ring,
+ * released by kernel when it exits, so writers never trust a stale pid */
+typedef struct _notification_shm_header {
+	unsigned int magic;
+	unsigned int size;
+	volatile unsigned int option;	/* NOTIFICATION_ONGOING_CHANNEL_OPTION_XXX */
+	volatile unsigned int reserved;	/* records taken by writers */
+	volatile unsigned int written;	/* futex word, bumped per record */
+	volatile int waiters;
+	notification_shm_record_s records[NOTIFICATION_SHM_RECORDS];
+} notification_shm_header_s;
+
+static pthread_mutex_t g_shm_lock = PTHREAD_MUTEX_INITIALIZER;
+static notification_shm_header_s *g_shm_writer = NULL;
+static int g_shm_writer_fd = -1;
+static int g_shm_writer_enabled = 0;
+static int g_shm_writer_exclusive = 0;
+static time_t g_shm_checked = 0;
+
+static notification_shm_header_s *g_shm_reader = NULL;
+static int g_shm_reader_fd = -1;
+static unsigned int g_shm_read_pos = 0;
+static unsigned int g_shm_stuck_pos = 0;
+static int g_shm_stuck = 0;
+
+static int _notification_shm_futex(volatile unsigned int *addr, int op,
+				   unsigned int val,
+				   const struct timespec *timeout)
+{
+	return syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+}
+
+/* Map ring, fd is kept open for lock of viewer */
+static notification_shm_header_s *_notification_shm_map(int oflag, int *fd_out)
+{
+	notification_shm_header_s *shm = NULL;
+	struct stat st;
+	int fd = -1;
+
+	fd = shm_open(NOTIFICATION_SHM_NAME, oflag, NOTIFICATION_SHM_MODE);
+	if (fd < 0) {
+		return NULL;
+	}
+
+	if (oflag & O_CREAT) {
+		/* umask is not applied, group may not be set for other user */
+		if (fchown(fd, -1, NOTIFICATION_SHM_GID) != 0) {
+			NOTIFICATION_INFO("Group of %s is not changed : %d",
+					  NOTIFICATION_SHM_NAME, errno);
+		}
+		fchmod(fd, NOTIFICATION_SHM_MODE);
+		if (fstat(fd, &st) == 0
+		    && st.st_size < sizeof(notification_shm_header_s)
+		    && ftruncate(fd, sizeof(notification_shm_header_s)) != 0) {
+			goto err;
+		}
+	}
+
+	/* Ring any user can write is not trusted */
+	if (fstat(fd, &st) != 0
+	    || st.st_size < sizeof(notification_shm_header_s)
+	    || (st.st_mode & S_IWOTH)) {
+		goto err;
+	}
+
+	shm = mmap(NULL, sizeof(notification_shm_header_s),
+		   PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (shm == MAP_FAILED) {
+		goto err;
+	}
+
+	*fd_out = fd;
+
+	return shm;
+
+ err:
+	close(fd);
+
+	return NULL;
+}
+
+static void _notification_shm_unmap(notification_shm_header_s * shm, int fd)
+{
+	munmap(shm, sizeof(notification_shm_header_s));
+	close(fd);
+}
+
+static int _notification_shm_is_valid(notification_shm_header_s * shm)
+{
+	return shm->magic == NOTIFICATION_SHM_MAGIC
+	    && shm->size == sizeof(notification_shm_header_s);
+}
+
+static int _notification_shm_reader_alive(int fd)
+{
+	struct flock fl;
+
+	/* Lock of own process is not reported by F_GETLK */
+	if (g_shm_reader != NULL) {
+		return 1;
+	}
+
+	memset(&fl, 0, sizeof(fl));
+	fl.l_type = F_WRLCK;
+	fl.l_whence = SEEK_SET;
+	fl.l_start = 0;
+	fl.l_len = 1;
+
+	if (fcntl(fd, F_GETLK, &fl) != 0) {
+		return 0;
+	}
+
+	return fl.l_type != F_UNLCK;
+}
+
+/* Viewer may take updates off D-Bus only if it runs as root, which no
+ * application can pretend to be by creating the object first */
+static int _notification_shm_is_exclusive(notification_shm_header_s * shm,
+					  int fd)
+{
+	struct stat st;
+
+	if (!(shm->option & NOTIFICATION_ONGOING_CHANNEL_OPTION_EXCLUSIVE)) {
+		return 0;
+	}
+
+	return fstat(fd, &st) == 0 && st.st_uid == 0;
+}
+
+notification_error_e notification_shm_write(notification_ongoing_update_type_e type,
+					    const char *pkgname,
+					    int priv_id, double value,
+					    int *exclusive)
+{
+	notification_shm_header_s *shm = NULL;
+	notification_shm_record_s *record = NULL;
+	unsigned int index = 0;
+	time_t now = 0;
+
+	*exclusive = 0;
+
+	if (pkgname == NULL
+	    || strlen(pkgname) >= NOTIFICATION_SHM_PKGNAME_LEN) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	pthread_mutex_lock(&g_shm_lock);
+
+	now = time(NULL);
+	if (now - g_shm_checked >= NOTIFICATION_SHM_CHECK_INTERVAL
+	    || now < g_shm_checked) {
+		g_shm_checked = now;
+
+		if (g_shm_writer == NULL) {
+			g_shm_writer = _notification_shm_map(O_RDWR,
+							     &g_shm_writer_fd);
+		}
+
+		g_shm_writer_enabled = g_shm_writer != NULL
+		    && _notification_shm_is_valid(g_shm_writer)
+		    && _notification_shm_reader_alive(g_shm_writer_fd);
+		g_shm_writer_exclusive = g_shm_writer_enabled
+		    && _notification_shm_is_exclusive(g_shm_writer,
+						      g_shm_writer_fd);
+	}
+
+	shm = g_shm_writer_enabled ? g_shm_writer : NULL;
+	*exclusive = g_shm_writer_exclusive;
+
+	pthread_mutex_unlock(&g_shm_lock);
+
+	if (shm == NULL) {
+		return NOTIFICATION_ERROR_FROM_DBUS;
+	}
+
+	index = __sync_fetch_and_add(&shm->reserved, 1);
+	record = &shm->records[index % NOTIFICATION_SHM_RECORDS];
+
+	record->seq = index * 2 + 1;
+	__sync_synchronize();
+
+	record->type = type;
+	record->priv_id = priv_id;
+	record->value = value;
+	strncpy(record->pkgname, pkgname, NOTIFICATION_SHM_PKGNAME_LEN);
+
+	__sync_synchronize();
+	record->seq = index * 2 + 2;
+
+	__sync_fetch_and_add(&shm->written, 1);
+	if (shm->waiters > 0) {
+		_notification_shm_futex(&shm->written, FUTEX_WAKE, INT_MAX,
+					NULL);
+	}
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+notification_error_e notification_shm_reader_open(int option)
+{
+	notification_shm_header_s *shm = NULL;
+	struct flock fl;
+	struct stat st;
+	int fd = -1;
+
+	if (g_shm_reader != NULL) {
+		return NOTIFICATION_ERROR_NONE;
+	}
+
+	shm = _notification_shm_map(O_RDWR | O_CREAT, &fd);
+	if (shm == NULL) {
+		NOTIFICATION_ERR("Fail to open %s : %d", NOTIFICATION_SHM_NAME,
+				 errno);
+		return NOTIFICATION_ERROR_NO_MEMORY;
+	}
+
+	/* Only user who created the object reads it */
+	if (fstat(fd, &st) != 0 || st.st_uid != geteuid()) {
+		NOTIFICATION_ERR("%s is owned by other user",
+				 NOTIFICATION_SHM_NAME);
+		_notification_shm_unmap(shm, fd);
+		return NOTIFICATION_ERROR_PERMISSION_DENIED;
+	}
+
+	if (shm->magic == 0) {
+		shm->size = sizeof(notification_shm_header_s);
+		__sync_synchronize();
+		shm->magic = NOTIFICATION_SHM_MAGIC;
+	}
+
+	if (!_notification_shm_is_valid(shm)) {
+		NOTIFICATION_ERR("Invalid %s", NOTIFICATION_SHM_NAME);
+		_notification_shm_unmap(shm, fd);
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	memset(&fl, 0, sizeof(fl));
+	fl.l_type = F_WRLCK;
+	fl.l_whence = SEEK_SET;
+	fl.l_start = 0;
+	fl.l_len = 1;
+
+	if (fcntl(fd, F_SETLK, &fl) != 0) {
+		NOTIFICATION_ERR("%s is read by other process : %d",
+				 NOTIFICATION_SHM_NAME, errno);
+		_notification_shm_unmap(shm, fd);
+		return NOTIFICATION_ERROR_ALREADY_EXIST_ID;
+	}
+
+	shm->option = option;
+	g_shm_read_pos = shm->reserved;
+	g_shm_stuck = 0;
+	g_shm_reader = shm;
+	g_shm_reader_fd = fd;
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+static int _notification_shm_read_records(void (*cb)(void *data,
+						     notification_ongoing_update_type_e type,
+						     const char *pkgname,
+						     int priv_id,
+						     double value),
+					  void *data)
+{
+	notification_shm_header_s *shm = g_shm_reader;
+	notification_shm_record_s *record = NULL;
+	notification_shm_record_s copy;
+	unsigned int reserved = 0;
+	unsigned int seq = 0;
+	int count = 0;
+
+	while (1) {
+		reserved = shm->reserved;
+		if (g_shm_read_pos == reserved) {
+			break;
+		}
+
+		/* Ring was overwritten, older records are lost */
+		if ((int)(reserved - g_shm_read_pos) > NOTIFICATION_SHM_RECORDS) {
+			g_shm_read_pos = reserved - NOTIFICATION_SHM_RECORDS;
+		}
+
+		record = &shm->records[g_shm_read_pos %
+				       NOTIFICATION_SHM_RECORDS];
+		seq = record->seq;
+
+		if ((int)(seq - (g_shm_read_pos * 2 + 2)) < 0) {
+			/* Record is being written. If it was so at last read
+			 * too, writer died in it, skip it. */
+			if (!g_shm_stuck || g_shm_stuck_pos != g_shm_read_pos) {
+				g_shm_stuck = 1;
+				g_shm_stuck_pos = g_shm_read_pos;
+				break;
+			}
+		} else if (seq == g_shm_read_pos * 2 + 2) {
+			__sync_synchronize();
+			memcpy(&copy, record, sizeof(copy));
+			__sync_synchronize();
+
+			if (record->seq == seq) {
+				copy.pkgname[NOTIFICATION_SHM_PKGNAME_LEN - 1] = '\0';
+				cb(data, copy.type, copy.pkgname, copy.priv_id,
+				   copy.value);
+				count++;
+			}
+		}
+
+		g_shm_stuck = 0;
+		g_shm_read_pos++;
+	}
+
+	return count;
+}
+
+notification_error_e notification_shm_reader_read(void (*cb)(void *data,
+							     notification_ongoing_update_type_e type,
+							     const char *pkgname,
+							     int priv_id,
+							     double value),
+						  void *data,
+						  int timeout_msec)
+{
+	notification_shm_header_s *shm = g_shm_reader;
+	struct timespec timeout;
+	unsigned int written = 0;
+
+	if (shm == NULL || cb == NULL) {
+		return NOTIFICATION_ERROR_INVALID_DATA;
+	}
+
+	written = shm->written;
+
+	if (_notification_shm_read_records(cb, data) > 0
+	    || timeout_msec == 0) {
+		return NOTIFICATION_ERROR_NONE;
+	}
+
+	timeout.tv_sec = timeout_msec / 1000;
+	timeout.tv_nsec = (timeout_msec % 1000) * 1000000;
+
+	__sync_fetch_and_add(&shm->waiters, 1);
+	_notification_shm_futex(&shm->written, FUTEX_WAIT, written,
+				timeout_msec < 0 ? NULL : &timeout);
+	__sync_fetch_and_sub(&shm->waiters, 1);
+
+	_notification_shm_read_records(cb, data);
+
+	return NOTIFICATION_ERROR_NONE;
+}
+
+notification_error_e notification_shm_reader_close(void)
+{
+	if (g_shm_reader == NULL) {
+		return NOTIFICATION_ERROR_NONE;
+	}
+
+	/* Object is kept for writers mapping it, they go back to D-Bus
+	 * as lock is released by close */
+	g_shm_reader->option = NOTIFICATION_ONGOING_CHANNEL_OPTION_NONE;
+	_notification_shm_unmap(g_shm_reader, g_shm_reader_fd);
+	g_shm_reader = NULL;
+	g_shm_reader_fd = -1;
+
+	return NOTIFICATION_ERROR_NONE;
+}